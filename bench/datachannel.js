@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+// Measures data channel throughput between two connections of the same
+// process, in MB/s. The descriptions are exchanged through the operations
+// chain, the gathered candidates being appended to them as a=candidate lines.
+// Usage: node bench/datachannel.js [messageSize] [totalMiB]
+
+const RTCPeerConnection = require('../').RTCPeerConnection;
+
+const messageSize = parseInt(process.argv[2], 10) || 16384;
+const totalBytes = (parseInt(process.argv[3], 10) || 256) * 1048576;
+const highWaterMark = 1048576;
+
+function gatherCandidates(pc) {
+  return new Promise((resolve) => {
+    const lines = [];
+
+    pc.onicecandidate = (event) => {
+      if (event.candidate) {
+        lines.push('a=' + event.candidate.candidate + '\r\n');
+      } else {
+        resolve(lines.join(''));
+      }
+    };
+  });
+}
+
+function negotiate(offerer, answerer) {
+  const offererCandidates = gatherCandidates(offerer);
+  const answererCandidates = gatherCandidates(answerer);
+  let offer;
+  let answer;
+
+  // setLocalDescription is chained without awaiting createOffer.
+  return Promise.all([offerer.createOffer(), offerer.setLocalDescription()])
+    .then((results) => {
+      offer = results[0];
+      return offererCandidates;
+    })
+    .then((candidates) => answerer.setRemoteDescription({
+      type: 'offer',
+      sdp: offer.sdp + candidates
+    }))
+    .then(() => Promise.all([answerer.createAnswer(),
+                             answerer.setLocalDescription()]))
+    .then((results) => {
+      answer = results[0];
+      return answererCandidates;
+    })
+    .then((candidates) => offerer.setRemoteDescription({
+      type: 'answer',
+      sdp: answer.sdp + candidates
+    }));
+}
+
+const offerer = new RTCPeerConnection();
+const answerer = new RTCPeerConnection();
+const channel = offerer.createDataChannel('bench');
+const payload = Buffer.alloc(messageSize, 0x61);
+
+let sent = 0;
+let received = 0;
+let start;
+
+function pump() {
+  while (sent < totalBytes && channel.bufferedAmount < highWaterMark) {
+    channel.send(payload);
+    sent += messageSize;
+  }
+}
+
+answerer.ondatachannel = (event) => {
+  const remote = event.channel;
+  remote.binaryType = 'nodebuffer';
+
+  remote.onmessage = (message) => {
+    received += message.data.length;
+
+    if (received < totalBytes) {
+      return;
+    }
+
+    const elapsed = process.hrtime(start);
+    const seconds = elapsed[0] + elapsed[1] / 1e9;
+
+    console.log('message size:       %d bytes', messageSize);
+    console.log('transferred:        %s MiB',
+      (received / 1048576).toFixed(1));
+    console.log('throughput:         %s MB/s',
+      (received / 1e6 / seconds).toFixed(1));
+    process.exit(0);
+  };
+};
+
+channel.bufferedAmountLowThreshold = highWaterMark / 2;
+channel.onbufferedamountlow = pump;
+channel.onopen = () => {
+  start = process.hrtime();
+  pump();
+};
+
+negotiate(offerer, answerer).catch((err) => {
+  console.error(err);
+  process.exit(1);
+});
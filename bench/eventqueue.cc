@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Stress test comparing the lock-free EventQueue storage against the
+// mutex-guarded vector it replaced, with many producer threads and a single
+// consumer draining as the Node main thread does.
+//
+// Build: c++ -std=c++11 -O2 -pthread -Isrc bench/eventqueue.cc -o eventqueue
+// Usage: ./eventqueue [producers] [events per producer]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "event/mpscqueue.h"
+
+typedef std::chrono::steady_clock Clock;
+
+struct Item : public MpscNode {
+  int producer;
+  int sequence;
+};
+
+class LockedQueue {
+ public:
+  void Push(Item *item) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _queue.push_back(item);
+  }
+
+  template <class F>
+  size_t Drain(F handle) {
+    std::vector<Item*> items;
+
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      std::copy(_queue.begin(), _queue.end(), std::back_inserter(items));
+      _queue.clear();
+    }
+
+    std::for_each(items.begin(), items.end(), handle);
+    return items.size();
+  }
+
+ private:
+  std::mutex _mutex;
+  std::vector<Item*> _queue;
+};
+
+class LockFreeQueue {
+ public:
+  void Push(Item *item) {
+    _queue.Push(item);
+  }
+
+  template <class F>
+  size_t Drain(F handle) {
+    size_t count = 0;
+    Item *item;
+
+    while ((item = _queue.Pop())) {
+      handle(item);
+      ++count;
+    }
+
+    return count;
+  }
+
+ private:
+  MpscQueue<Item> _queue;
+};
+
+template <class Q>
+void Run(const char *name, int producers, int perProducer) {
+  Q queue;
+  std::vector<Item> items(static_cast<size_t>(producers) * perProducer);
+  std::vector<int> lastSequence(producers, -1);
+  std::vector<double> latencies(producers);
+  std::atomic<int> running(producers);
+  std::vector<std::thread> threads;
+  size_t received = 0;
+  bool ordered = true;
+
+  Clock::time_point start = Clock::now();
+
+  for (int p = 0; p < producers; ++p) {
+    threads.push_back(std::thread([&, p]() {
+      Clock::time_point begin = Clock::now();
+
+      for (int i = 0; i < perProducer; ++i) {
+        Item *item = &items[static_cast<size_t>(p) * perProducer + i];
+        item->producer = p;
+        item->sequence = i;
+        queue.Push(item);
+      }
+
+      std::chrono::duration<double, std::nano> spent = Clock::now() - begin;
+      latencies[p] = spent.count() / perProducer;
+      running.fetch_sub(1);
+    }));
+  }
+
+  auto handle = [&](Item *item) {
+    if (item->sequence != lastSequence[item->producer] + 1) {
+      ordered = false;
+    }
+
+    lastSequence[item->producer] = item->sequence;
+  };
+
+  while (running.load() > 0 || received < items.size()) {
+    received += queue.Drain(handle);
+  }
+
+  std::chrono::duration<double> elapsed = Clock::now() - start;
+
+  for (size_t i = 0; i < threads.size(); ++i) {
+    threads[i].join();
+  }
+
+  double latency = 0;
+  for (int p = 0; p < producers; ++p) {
+    latency += latencies[p];
+  }
+
+  std::printf("%-10s %8.1f ns/push %10.2f Mevents/s %s\n", name,
+              latency / producers, received / elapsed.count() / 1e6,
+              ordered && received == items.size() ? "ok" : "BROKEN");
+}
+
+int main(int argc, char **argv) {
+  int producers = argc > 1 ? std::atoi(argv[1]) : 8;
+  int perProducer = argc > 2 ? std::atoi(argv[2]) : 1000000;
+
+  std::printf("%d producers, %d events each\n", producers, perProducer);
+  Run<LockedQueue>("mutex", producers, perProducer);
+  Run<LockFreeQueue>("lock-free", producers, perProducer);
+
+  return 0;
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+// Measures per-connection construction time and resident memory growth.
+// Usage: node bench/peerconnection.js [count]
+//
+// Compare two builds with the same count on an otherwise idle machine, each
+// in a fresh process. Connections sharing a pooled factory are expected to
+// show most of the difference in the rss growth line.
+
+const RTCPeerConnection = require('../').RTCPeerConnection;
+
+const count = parseInt(process.argv[2], 10) || 1000;
+const connections = [];
+
+const rssBefore = process.memoryUsage().rss;
+const start = process.hrtime();
+
+for (let i = 0; i < count; i++) {
+  connections.push(new RTCPeerConnection());
+}
+
+const elapsed = process.hrtime(start);
+const rssAfter = process.memoryUsage().rss;
+const totalMs = elapsed[0] * 1e3 + elapsed[1] / 1e6;
+
+console.log('connections:        %d', count);
+console.log('construction:       %s ms/connection',
+  (totalMs / count).toFixed(3));
+console.log('rss growth:         %s KiB/connection',
+  ((rssAfter - rssBefore) / 1024 / count).toFixed(1));
+console.log('rss total:          %s MiB', (rssAfter / 1048576).toFixed(1));
@@ -3,16 +3,53 @@
         {
             'target_name': 'webrtc',
             'sources': [
+                'src/addondata.cc',
+                'src/candidateinfo.cc',
+                'src/candidateparser.cc',
+                'src/certificategenerator.cc',
+                'src/certificatepool.cc',
+                'src/certificatestore.cc',
+                'src/event/candidatesparsedevent.cc',
+                'src/event/certificatestoreevent.cc',
+                'src/event/channelbufferedamountevent.cc',
+                'src/event/channelevent.cc',
+                'src/event/channelmessageevent.cc',
+                'src/event/channelmessagesevent.cc',
+                'src/event/channelstateevent.cc',
                 'src/event/createsessiondescriptionevent.cc',
+                'src/event/datachannelevent.cc',
+                'src/event/eventpool.cc',
                 'src/event/eventqueue.cc',
+                'src/event/generatecertificateevent.cc',
+                'src/event/getstatsevent.cc',
+                'src/event/icecandidateevent.cc',
+                'src/event/icecandidatesevent.cc',
+                'src/event/negotiationneededevent.cc',
+                'src/event/peerconnectionevent.cc',
+                'src/event/sessiondescriptionparsedevent.cc',
+                'src/event/setsessiondescriptionevent.cc',
+                'src/event/statechangeevent.cc',
+                'src/event/statsalertevent.cc',
                 'src/globals.cc',
+                'src/logger.cc',
                 'src/module.cc',
                 'src/observer/createsessiondescriptionobserver.cc',
+                'src/observer/datachannelobserver.cc',
                 'src/observer/peerconnectionobserver.cc',
+                'src/observer/rtcstatscollectorobserver.cc',
+                'src/observer/setsessiondescriptionobserver.cc',
+                'src/operationschain.cc',
+                'src/paralleljob.cc',
                 'src/rtccertificate.cc',
+                'src/rtcdatachannel.cc',
                 'src/rtcicecandidate.cc',
                 'src/rtcpeerconnection.cc',
                 'src/rtcsessiondescription.cc',
+                'src/sessiondescriptionparser.cc',
+                'src/stats.cc',
+                'src/statssampler.cc',
+                'src/stringtable.cc',
+                'src/threadgroup.cc',
             ],
             'include_dirs' : [
                 'build/include',
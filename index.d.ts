@@ -3,5 +3,92 @@
 // Definitions by: Axel Isouard <axel@isouard.fr>
 // Definitions: https://github.com/DefinitelyTyped/DefinitelyTyped
 
+/// <reference path="lib/RTCDataChannel.d.ts" />
 /// <reference path="lib/RTCIceCandidate.d.ts" />
 /// <reference path="lib/RTCSessionDescription.d.ts" />
+
+interface EventPoolStats {
+    heapAllocations: number;
+    pooledAllocations: number;
+    releases: number;
+    remoteReleases: number;
+}
+
+declare function getEventPoolStats(): EventPoolStats;
+
+interface CertificatePoolOptions {
+    // Certificates kept ready for each key type, 0 (the default) disables it.
+    // Only ECDSA P-256 and RSA 2048 with exponent 65537 are pooled, and new
+    // connections take ECDSA ones.
+    ecdsa?: number;
+    rsa?: number;
+}
+
+interface CertificatePoolStats {
+    hits: number;
+    misses: number;
+    // Certificates currently ready.
+    ecdsa: number;
+    rsa: number;
+}
+
+declare function getCertificatePoolStats(): CertificatePoolStats;
+
+interface ThreadOptions {
+    signaling?: string;
+    worker?: string;
+    // null or false runs socket I/O on the worker thread.
+    network?: string | null | false;
+}
+
+// 'least-connections' counts the connections not closed yet. Without
+// close(), a connection which is no longer used still counts until it has
+// been garbage collected.
+type PlacementPolicy = 'round-robin' | 'least-connections';
+
+interface StatsSamplerOptions {
+    // Sampling period in milliseconds, 0 (the default) disables the sampler.
+    period?: number;
+    // Samples kept per connection, 60 by default.
+    history?: number;
+    // Names from RTCPeerConnection.statsSchema, all of them by default.
+    fields?: string[];
+}
+
+interface ConfigureOptions {
+    threads?: ThreadOptions;
+    threadGroups?: number;
+    placement?: PlacementPolicy;
+    stats?: StatsSamplerOptions;
+    certificatePool?: CertificatePoolOptions;
+}
+
+interface ThreadInfo {
+    group: number;
+    role: 'signaling' | 'worker' | 'network';
+    name: string;
+}
+
+interface ThreadGroupInfo {
+    id: number;
+    connections: number;
+    totalConnections: number;
+    threads: ThreadInfo[];
+}
+
+declare function configure(options: ConfigureOptions): void;
+declare function getThreads(): ThreadInfo[];
+declare function getThreadGroups(): ThreadGroupInfo[];
+
+type LogCategory = 'peerconnection' | 'datachannel';
+type LogLevel = 'verbose' | 'info' | 'warning' | 'error' | 'none';
+type LogSink = 'stdout' | 'stderr' | 'webrtc';
+
+interface LogStats {
+    levels: { [category: string]: LogLevel };
+    dropped: number;
+}
+
+declare function setLogLevel(category: LogCategory, level: LogLevel): void;
+declare function setLogSink(sink: LogSink): void;
+declare function getLogStats(): LogStats;
@@ -1,3 +1,4 @@
 'use strict';
 
 module.exports = require('bindings')('webrtc');
+module.exports.DataChannelStream = require('./lib/DataChannelStream');
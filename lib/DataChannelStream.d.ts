@@ -0,0 +1,23 @@
+// Type definitions for node-webrtc
+// Project: https://github.com/aisouard/node-webrtc/
+// Definitions by: Axel Isouard <axel@isouard.fr>
+// Definitions: https://github.com/DefinitelyTyped/DefinitelyTyped
+
+/// <reference path="RTCDataChannel.d.ts" />
+
+import { Duplex, DuplexOptions } from 'stream';
+
+interface DataChannelStreamOptions extends DuplexOptions {
+    // Channel bufferedAmount at which write() starts returning false.
+    highWaterMark?: number;
+    // bufferedAmountLowThreshold at which 'drain' is emitted again.
+    lowWaterMark?: number;
+}
+
+declare class DataChannelStream extends Duplex {
+    constructor(channel: RTCDataChannel, options?: DataChannelStreamOptions);
+
+    readonly channel: RTCDataChannel;
+}
+
+export = DataChannelStream;
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+const Duplex = require('stream').Duplex;
+
+const kDefaultHighWaterMark = 1024 * 1024;
+
+/**
+ * Duplex stream over a RTCDataChannel. It owns the channel's onopen,
+ * onmessage, onclose and onbufferedamountlow handlers.
+ *
+ * write() returns false once the channel's bufferedAmount reaches
+ * highWaterMark. Pending writes are then held back, and 'drain' is emitted
+ * once the channel fires bufferedamountlow at lowWaterMark. Received
+ * messages are pushed as Buffers. A data channel cannot be paused, so the
+ * readable side does not apply backpressure to the remote peer.
+ */
+class DataChannelStream extends Duplex {
+  constructor(channel, options) {
+    options = options || {};
+    super(options);
+
+    this._channel = channel;
+    this._highWaterMark = options.highWaterMark || kDefaultHighWaterMark;
+    this._lowWaterMark = options.lowWaterMark !== undefined ?
+      options.lowWaterMark : this._highWaterMark / 4;
+    this._pending = null;
+    this._needDrain = false;
+
+    channel.binaryType = 'nodebuffer';
+    channel.bufferedAmountLowThreshold = this._lowWaterMark;
+
+    channel.onopen = () => this._flushPending();
+    channel.onbufferedamountlow = () => this._onBufferedAmountLow();
+    channel.onclose = () => {
+      this.push(null);
+      this._flushPending(new Error('The data channel has been closed.'));
+    };
+    channel.onmessage = (event) => {
+      this.push(typeof event.data === 'string' ?
+        Buffer.from(event.data) : event.data);
+    };
+
+    this.once('finish', () => channel.close());
+  }
+
+  get channel() {
+    return this._channel;
+  }
+
+  write(chunk, encoding, callback) {
+    const ret = super.write(chunk, encoding, callback);
+
+    if (this._channel.bufferedAmount >= this._highWaterMark) {
+      this._needDrain = true;
+      return false;
+    }
+
+    return ret;
+  }
+
+  _write(chunk, encoding, callback) {
+    if (this._channel.readyState === 'connecting') {
+      this._pending = { chunk: chunk, callback: callback };
+      return;
+    }
+
+    try {
+      this._channel.send(chunk);
+    } catch (err) {
+      return callback(err);
+    }
+
+    if (this._channel.bufferedAmount >= this._highWaterMark) {
+      this._pending = { chunk: null, callback: callback };
+      return;
+    }
+
+    callback();
+  }
+
+  _read() {
+  }
+
+  _onBufferedAmountLow() {
+    this._flushPending();
+
+    if (this._needDrain) {
+      this._needDrain = false;
+      this.emit('drain');
+    }
+  }
+
+  _flushPending(err) {
+    const pending = this._pending;
+
+    if (!pending) {
+      return;
+    }
+
+    this._pending = null;
+
+    if (err || pending.chunk === null) {
+      return pending.callback(err);
+    }
+
+    this._write(pending.chunk, null, pending.callback);
+  }
+}
+
+module.exports = DataChannelStream;
@@ -15,9 +15,18 @@ interface RTCCertificatePEM {
 
 class RTCCertificate {
     static fromPEM(pemCertificate: RTCCertificatePEM): RTCCertificate;
+
+    // Non-standard: saves many certificates to a single file, and loads them
+    // back off the main thread. Expired entries are skipped on load and
+    // removed from the file.
+    static save(path: string, certificates: RTCCertificate[]): Promise<void>;
+    static load(path: string): Promise<RTCCertificate[]>;
+
     toPEM(): RTCCertificatePEM;
 
     readonly expires: number;
-    readonly fingerprints: RTCDtlsFingerprint[];
+    // Frozen, and the same array on every access: sha-256, sha-384, sha-512
+    // and sha-1, in that order.
+    readonly fingerprints: ReadonlyArray<RTCDtlsFingerprint>;
     // getAlgorithm(): AlgorithmIdentifier;
 }
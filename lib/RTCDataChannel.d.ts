@@ -0,0 +1,57 @@
+// Type definitions for node-webrtc
+// Project: https://github.com/aisouard/node-webrtc/
+// Definitions by: Axel Isouard <axel@isouard.fr>
+// Definitions: https://github.com/DefinitelyTyped/DefinitelyTyped
+
+type RTCDataChannelState = 'connecting' | 'open' | 'closing' | 'closed';
+// Non-standard: 'nodebuffer' delivers binary messages as Node Buffers.
+type RTCDataChannelBinaryType = 'arraybuffer' | 'nodebuffer';
+
+interface RTCDataChannelInit {
+    ordered?: boolean;
+    maxPacketLifeTime?: number;
+    maxRetransmits?: number;
+    protocol?: string;
+    negotiated?: boolean;
+    id?: number;
+}
+
+interface RTCDataChannelMessageEvent {
+    readonly type: 'message';
+    readonly data: string | ArrayBuffer | Buffer;
+}
+
+// Non-standard: the messages received between two event loop turns, when
+// batchMessages is set. Message i spans data[offsets[i]..offsets[i + 1]),
+// binary[i] tells whether it was sent as binary or as UTF-8 text.
+interface RTCDataChannelMessagesEvent {
+    readonly type: 'messages';
+    readonly data: ArrayBuffer | Buffer;
+    readonly offsets: Uint32Array;
+    readonly binary: Uint8Array;
+}
+
+class RTCDataChannel {
+    readonly label: string;
+    readonly ordered: boolean;
+    readonly maxPacketLifeTime: number | null;
+    readonly maxRetransmits: number | null;
+    readonly protocol: string;
+    readonly negotiated: boolean;
+    readonly id: number | null;
+    readonly readyState: RTCDataChannelState;
+    readonly bufferedAmount: number;
+    bufferedAmountLowThreshold: number;
+    binaryType: RTCDataChannelBinaryType;
+    // Non-standard: deliver received messages through onmessages.
+    batchMessages: boolean;
+
+    send(data: string | Buffer | ArrayBuffer | ArrayBufferView): void;
+    close(): void;
+
+    onopen: (this: RTCDataChannel, event: Event) => any;
+    onclose: (this: RTCDataChannel, event: Event) => any;
+    onmessage: (this: RTCDataChannel, event: RTCDataChannelMessageEvent) => any;
+    onmessages: (this: RTCDataChannel, event: RTCDataChannelMessagesEvent) => any;
+    onbufferedamountlow: (this: RTCDataChannel, event: Event) => any;
+}
@@ -16,6 +16,11 @@ interface RTCIceCandidateInit {
 class RTCIceCandidate {
     constructor(candidateInitDict: RTCIceCandidateInit);
 
+    // Non-standard: parses many candidates off the main thread. Invalid lines
+    // resolve to an Error in place of their candidate.
+    static parseMany(candidates: RTCIceCandidateInit[]):
+        Promise<Array<RTCIceCandidate | Error>>;
+
     readonly candidate: string;
     readonly sdpMid?: string;
     readonly sdpMLineIndex?: number;
@@ -16,6 +16,20 @@ type RTCIceTransportPolicy = 'relay' | 'all';
 type RTCBundlePolicy = 'balanced' | 'max-compat' | 'max-bundle';
 type RTCRtcpMuxPolicy = 'negotiate' | 'require';
 
+interface RTCConfiguration {
+    // Non-standard: thread group to place the connection on, bypassing the
+    // placement policy.
+    threadGroup?: number;
+    // Non-standard: index of the pooled PeerConnectionFactory to use.
+    factory?: number;
+    // Non-standard: when set, ICE candidates are collected for up to this
+    // many milliseconds and delivered through onicecandidates.
+    iceCandidateBatchWindow?: number;
+    // Only the first certificate is used. Sharing one between connections
+    // spares each of them its own key generation.
+    certificates?: RTCCertificate[];
+}
+
 /*interface RTCConfiguration {
     iceServers: RTCIceServer[];
     iceTransportPolicy: RTCIceTransportPolicy;
@@ -93,8 +107,33 @@ interface RTCOfferOptions {
     iceRestart: boolean;
 }
 
+interface RTCAnswerOptions {
+}
+
+interface RTCPeerConnectionIceBatchEvent {
+    readonly type: 'icecandidates';
+    readonly candidates: RTCIceCandidate[];
+    readonly endOfCandidates: boolean;
+}
+
+interface RTCStatsAlertEvent {
+    readonly type: 'statsalert';
+    readonly field: string;
+    readonly value: number;
+    readonly threshold: number;
+}
+
+interface RTCStats {
+    id: string;
+    type: string;
+    timestamp: number;
+    [member: string]: any;
+}
+
+type RTCStatsReport = Map<string, RTCStats>;
+
 class RTCPeerConnection {
-    // constructor (configuration?: RTCConfiguration);
+    constructor (configuration?: RTCConfiguration);
 
     createOffer(options: RTCOfferOptions,
                 successCallback:
@@ -107,6 +146,35 @@ class RTCPeerConnection {
 
     createOffer(options?: RTCOfferOptions): Promise<RTCSessionDescriptionInit>;
 
+    createAnswer(options: RTCAnswerOptions,
+                 successCallback:
+                     (descriptionInitDict: RTCSessionDescriptionInit) => void,
+                 failureCallback: (error: Error) => void);
+
+    createAnswer(successCallback:
+                     (descriptionInitDict: RTCSessionDescriptionInit) => void,
+                 failureCallback: (error: Error) => void);
+
+    createAnswer(options?: RTCAnswerOptions): Promise<RTCSessionDescriptionInit>;
+
+    // Without a description, sets the last created offer or answer, creating
+    // one first when there is none. Calls are chained natively and need not
+    // wait for the previous one to settle.
+    setLocalDescription(description?: RTCSessionDescriptionInit): Promise<void>;
+
+    setLocalDescription(description: RTCSessionDescriptionInit,
+                        successCallback: () => void,
+                        failureCallback: (error: Error) => void);
+
+    setRemoteDescription(description: RTCSessionDescriptionInit): Promise<void>;
+
+    setRemoteDescription(description: RTCSessionDescriptionInit,
+                         successCallback: () => void,
+                         failureCallback: (error: Error) => void);
+
+    createDataChannel(label: string,
+                      dataChannelDict?: RTCDataChannelInit): RTCDataChannel;
+
     readonly currentLocalDescription: RTCSessionDescription;
     readonly pendingLocalDescription: RTCSessionDescription;
     readonly currentRemoteDescription: RTCSessionDescription;
@@ -116,16 +184,40 @@ class RTCPeerConnection {
     readonly iceConnectionState: RTCIceConnectionState;
     readonly connectionState: RTCPeerConnectionState;
 
+    getStats(): Promise<RTCStatsReport>;
+
+    // Non-standard: writes the counters named by statsSchema into
+    // array[offset...]. A Float64Array gets standard units, timestamp in
+    // milliseconds and times in seconds. A BigUint64Array (Node 10.4+) gets
+    // exact integers, timestamp and times in microseconds.
+    getStats<T extends Float64Array>(array: T, offset?: number): Promise<T>;
+
+    // Non-standard: the samples taken by the native stats sampler, oldest
+    // first, one row of configure({ stats: { fields } }) values per sample.
+    getStatsHistory(): Float64Array;
+
+    // Non-standard: fires onstatsalert when a sampled value goes above the
+    // threshold, counters being compared by their increase over one period.
+    // A null threshold removes the alert.
+    setStatsAlert(field: string, threshold: number | null): void;
+
+    static readonly statsSchema: string[];
+
     static generateCertificate(keygenAlgorithm: AlgorithmIdentifier): Promise<RTCCertificate>;
 
+    ondatachannel: (this: RTCPeerConnection, event: RTCDataChannelEvent) => any;
+    onicecandidate: (this: RTCPeerConnection, event: RTCPeerConnectionIceEvent) => any;
+    // Non-standard: only fired when iceCandidateBatchWindow is set.
+    onicecandidates: (this: RTCPeerConnection, event: RTCPeerConnectionIceBatchEvent) => any;
+    oniceconnectionstatechange: (this: RTCPeerConnection, event: Event) => any;
+    onicegatheringstatechange: (this: RTCPeerConnection, event: Event) => any;
+    onnegotiationneeded: (this: RTCPeerConnection, event: Event) => any;
+    onsignalingstatechange: (this: RTCPeerConnection, event: Event) => any;
+    // Non-standard: only fired for the alerts set with setStatsAlert().
+    onstatsalert: (this: RTCPeerConnection, event: RTCStatsAlertEvent) => any;
+
     /*onconnectionstatechange: Event;
-    ondatachannel: RTCDataChannelEvent;
-    onicecandidate: RTCPeerConnectionIceEvent;
     onicecandidateerror: RTCPeerConnectionIceErrorEvent;
-    oniceconnectionstatechange: Event;
-    onicegatheringstatechange: Event;
     onisolationchange: Event;
-    onnegotiationneeded: Event;
-    onsignalingstatechange: Event;
     ontrack: RTCTrackEvent;*/
 }
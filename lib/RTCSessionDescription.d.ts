@@ -13,6 +13,10 @@ interface RTCSessionDescriptionInit {
 class RTCSessionDescription {
     constructor(descriptionInitDict: RTCSessionDescriptionInit);
 
+    // Non-standard: parses the SDP off the main thread.
+    static parse(descriptionInitDict: RTCSessionDescriptionInit):
+        Promise<RTCSessionDescription>;
+
     readonly type: RTCSdpType;
     readonly sdp: string;
 }
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <uv.h>
+#include <vector>
+#include "addondata.h"
+#include "rtcpeerconnection.h"
+#include "stringtable.h"
+
+static uv_key_t sDataKey;
+static uv_once_t sDataKeyOnce = UV_ONCE_INIT;
+
+static void CreateDataKey() {
+  uv_key_create(&sDataKey);
+}
+
+AddonData::AddonData()
+    : _eventQueue(EventQueue::Create()) {
+}
+
+AddonData::~AddonData() {
+  certificateConstructor.Reset();
+  certificateTemplate.Reset();
+  dataChannelTemplate.Reset();
+  iceCandidateTemplate.Reset();
+  peerConnectionTemplate.Reset();
+  sessionDescriptionConstructor.Reset();
+}
+
+AddonData *AddonData::Create() {
+  uv_once(&sDataKeyOnce, CreateDataKey);
+
+  AddonData *data = Get();
+
+  if (data) {
+    return data;
+  }
+
+  data = new AddonData();
+  uv_key_set(&sDataKey, data);
+
+  // Older versions have no workers, the exit handler destroys the data of
+  // the main thread.
+#if NODE_MODULE_VERSION >= NODE_10_0_MODULE_VERSION
+  node::AddEnvironmentCleanupHook(Isolate::GetCurrent(), Cleanup, data);
+#endif
+
+  return data;
+}
+
+AddonData *AddonData::Get() {
+  return static_cast<AddonData *>(uv_key_get(&sDataKey));
+}
+
+void AddonData::Destroy() {
+  AddonData *data = Get();
+
+  if (!data) {
+    return;
+  }
+
+#if NODE_MODULE_VERSION >= NODE_10_0_MODULE_VERSION
+  node::RemoveEnvironmentCleanupHook(Isolate::GetCurrent(), Cleanup, data);
+#endif
+
+  Cleanup(data);
+}
+
+void AddonData::Cleanup(void *arg) {
+  AddonData *data = static_cast<AddonData *>(arg);
+
+  // Stopped first, so that no event is pushed for them once the queue is
+  // closed. Tearing down unregisters them from the set.
+  std::vector<RTCPeerConnection *> connections(data->_connections.begin(),
+                                               data->_connections.end());
+
+  for (size_t i = 0; i < connections.size(); ++i) {
+    connections[i]->Teardown();
+  }
+
+  data->_eventQueue->Close();
+  data->_eventQueue = NULL;
+
+  StringTable::Cleanup();
+
+  uv_key_set(&sDataKey, NULL);
+  delete data;
+}
+
+EventQueue *AddonData::GetEventQueue() const {
+  return _eventQueue.get();
+}
+
+void AddonData::AddConnection(RTCPeerConnection *connection) {
+  _connections.insert(connection);
+}
+
+void AddonData::RemoveConnection(RTCPeerConnection *connection) {
+  _connections.erase(connection);
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ADDONDATA_H_
+#define ADDONDATA_H_
+
+#include <nan.h>
+#include <webrtc/base/scoped_ref_ptr.h>
+#include <set>
+#include "event/eventqueue.h"
+
+using namespace v8;
+
+class RTCPeerConnection;
+
+// The state the bindings keep per JavaScript environment: the main thread
+// and each worker_threads worker load the module into their own isolate and
+// event loop. Node runs every environment on its own thread, the data is
+// found through a thread-local key.
+class AddonData {
+ public:
+  // Creates the data of the calling thread's environment, and registers its
+  // cleanup for when the environment goes away.
+  static AddonData *Create();
+
+  // The data of the calling thread, NULL on threads which run no JavaScript
+  // and once the environment has been cleaned up.
+  static AddonData *Get();
+
+  // Cleans up the data of the calling thread now, if any. The process exit
+  // handler calls it before stopping the WebRTC threads.
+  static void Destroy();
+
+  EventQueue *GetEventQueue() const;
+
+  // Connections still alive when the environment goes away are closed, so
+  // that the WebRTC threads stop producing events for it.
+  void AddConnection(RTCPeerConnection *connection);
+  void RemoveConnection(RTCPeerConnection *connection);
+
+  Nan::Persistent<Function> certificateConstructor;
+  Nan::Persistent<FunctionTemplate> certificateTemplate;
+  Nan::Persistent<FunctionTemplate> dataChannelTemplate;
+  Nan::Persistent<FunctionTemplate> iceCandidateTemplate;
+  Nan::Persistent<FunctionTemplate> peerConnectionTemplate;
+  Nan::Persistent<Function> sessionDescriptionConstructor;
+
+ private:
+  AddonData();
+  ~AddonData();
+
+  static void Cleanup(void *arg);
+
+  rtc::scoped_refptr<EventQueue> _eventQueue;
+  std::set<RTCPeerConnection *> _connections;
+};
+
+#endif  // ADDONDATA_H_
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <webrtc/p2p/base/candidate.h>
+#include <webrtc/p2p/base/port.h>
+#include <memory>
+#include "candidateinfo.h"
+
+static const char eSerialize[] = "Failed to serialize ICE candidate.";
+
+CandidateInfo::CandidateInfo()
+    : sdpMLineIndex(0),
+      priority(0),
+      port(0),
+      hasRelatedAddress(false),
+      relatedPort(0) {
+}
+
+bool DescribeCandidate(const webrtc::IceCandidateInterface &iceCandidate,
+                       CandidateInfo *info) {
+  if (!iceCandidate.ToString(&info->candidate)) {
+    return false;
+  }
+
+  const cricket::Candidate &candidate = iceCandidate.candidate();
+
+  info->sdpMid = iceCandidate.sdp_mid();
+  info->sdpMLineIndex = iceCandidate.sdp_mline_index();
+  info->foundation = candidate.foundation();
+  info->priority = candidate.priority();
+  info->ip = candidate.address().ipaddr().ToString();
+  info->protocol = candidate.protocol();
+  info->port = candidate.address().port();
+  info->type = candidate.type();
+  info->tcpType = candidate.tcptype();
+  info->hasRelatedAddress = candidate.type() != cricket::LOCAL_PORT_TYPE &&
+                            !candidate.related_address().IsNil();
+
+  if (info->hasRelatedAddress) {
+    info->relatedAddress = candidate.related_address().ipaddr().ToString();
+    info->relatedPort = candidate.related_address().port();
+  }
+
+  return true;
+}
+
+bool ParseCandidate(const std::string &sdpMid, int sdpMLineIndex,
+                    const std::string &line, CandidateInfo *info,
+                    std::string *error) {
+  webrtc::SdpParseError parseError;
+  std::unique_ptr<webrtc::IceCandidateInterface> iceCandidate(
+      webrtc::CreateIceCandidate(sdpMid, sdpMLineIndex, line, &parseError));
+
+  if (!iceCandidate) {
+    *error = parseError.description;
+    return false;
+  }
+
+  if (!DescribeCandidate(*iceCandidate, info)) {
+    *error = eSerialize;
+    return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CANDIDATEINFO_H_
+#define CANDIDATEINFO_H_
+
+#include <webrtc/api/jsep.h>
+#include <cstdint>
+#include <string>
+
+// The fields of an ICE candidate, decoded once so that the RTCIceCandidate
+// getters never reserialize nor reparse it. Plain data, built on any thread.
+struct CandidateInfo {
+  CandidateInfo();
+
+  std::string candidate;
+  std::string sdpMid;
+  int sdpMLineIndex;
+
+  std::string foundation;
+  uint32_t priority;
+  std::string ip;
+  std::string protocol;
+  uint16_t port;
+  std::string type;
+  std::string tcpType;
+
+  // Unset for host candidates and when the line has no raddr.
+  bool hasRelatedAddress;
+  std::string relatedAddress;
+  uint16_t relatedPort;
+};
+
+// Returns false when the candidate cannot be serialized.
+bool DescribeCandidate(const webrtc::IceCandidateInterface &iceCandidate,
+                       CandidateInfo *info);
+
+// Returns false and the parser message when the line is invalid.
+bool ParseCandidate(const std::string &sdpMid, int sdpMLineIndex,
+                    const std::string &line, CandidateInfo *info,
+                    std::string *error);
+
+#endif  // CANDIDATEINFO_H_
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "candidateinfo.h"
+#include "candidateparser.h"
+#include "event/candidatesparsedevent.h"
+#include "paralleljob.h"
+
+class ParseCandidatesJob : public ParallelJob {
+ public:
+  ParseCandidatesJob(std::vector<CandidateInit> *candidates,
+                     Local<Promise::Resolver> resolver)
+      : _event(new CandidatesParsedEvent(resolver)) {
+    _candidates.swap(*candidates);
+  }
+
+ protected:
+  size_t Prepare() {
+    _results.resize(_candidates.size());
+    _errors.resize(_candidates.size());
+    return _candidates.size();
+  }
+
+  void Run(size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      const CandidateInit &init = _candidates[i];
+      ParseCandidate(init.sdpMid, init.sdpMLineIndex, init.candidate,
+                     &_results[i], &_errors[i]);
+    }
+  }
+
+  void Finish() {
+    _event->SetResults(&_results, &_errors);
+    GetEventQueue()->PushEvent(_event);
+  }
+
+ private:
+  CandidatesParsedEvent *_event;
+  std::vector<CandidateInit> _candidates;
+  std::vector<CandidateInfo> _results;
+  std::vector<std::string> _errors;
+};
+
+void CandidateParser::ParseMany(std::vector<CandidateInit> *candidates,
+                                Local<Promise::Resolver> resolver) {
+  ParallelJob *job = new ParseCandidatesJob(candidates, resolver);
+  job->Start();
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CANDIDATEPARSER_H_
+#define CANDIDATEPARSER_H_
+
+#include <nan.h>
+#include <string>
+#include <vector>
+
+using namespace v8;
+
+// An RTCIceCandidateInit dictionary, copied out of V8 so that it can be
+// parsed off the main thread.
+struct CandidateInit {
+  std::string candidate;
+  std::string sdpMid;
+  int sdpMLineIndex;
+};
+
+// Parses candidate lines in bulk on the libuv threadpool, the main thread
+// only wraps the results.
+class CandidateParser {
+ public:
+  // Resolves with one entry per input, in order: an RTCIceCandidate, or an
+  // Error when its line is invalid. Takes the contents of 'candidates'.
+  static void ParseMany(std::vector<CandidateInit> *candidates,
+                        Local<Promise::Resolver> resolver);
+};
+
+#endif  // CANDIDATEPARSER_H_
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <webrtc/base/rtccertificategenerator.h>
+#include "certificategenerator.h"
+#include "event/generatecertificateevent.h"
+#include "paralleljob.h"
+
+class GenerateCertificateJob : public ParallelJob {
+ public:
+  GenerateCertificateJob(const rtc::KeyParams &keyParams,
+                         Local<Promise::Resolver> resolver)
+      : _event(new GenerateCertificateEvent(resolver)),
+        _keyParams(keyParams) {
+  }
+
+ protected:
+  size_t Prepare() {
+    return 1;
+  }
+
+  void Run(size_t begin, size_t end) {
+    _event->SetCertificate(rtc::RTCCertificateGenerator::GenerateCertificate(
+        _keyParams, rtc::Optional<uint64_t>()));
+  }
+
+  void Finish() {
+    GetEventQueue()->PushEvent(_event);
+  }
+
+ private:
+  GenerateCertificateEvent *_event;
+  rtc::KeyParams _keyParams;
+};
+
+void CertificateGenerator::Generate(const rtc::KeyParams &keyParams,
+                                    Local<Promise::Resolver> resolver) {
+  ParallelJob *job = new GenerateCertificateJob(keyParams, resolver);
+  job->Start();
+}
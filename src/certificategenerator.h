@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CERTIFICATEGENERATOR_H_
+#define CERTIFICATEGENERATOR_H_
+
+#include <nan.h>
+#include <webrtc/base/sslidentity.h>
+
+using namespace v8;
+
+// Generates certificates on the libuv threadpool, key generation takes too
+// long for the main thread and for the WebRTC threads alike.
+class CertificateGenerator {
+ public:
+  // Resolves with an RTCCertificate, or rejects with a TypeError when the
+  // generation fails.
+  static void Generate(const rtc::KeyParams &keyParams,
+                       Local<Promise::Resolver> resolver);
+};
+
+#endif  // CERTIFICATEGENERATOR_H_
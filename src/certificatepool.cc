@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <webrtc/base/rtccertificategenerator.h>
+#include "certificatepool.h"
+#include "rtccertificate.h"
+
+static const char kThreadName[] = "certificate_pool_thread";
+
+enum {
+  kRefill,
+};
+
+static rtc::KeyParams GetKeyParams(CertificatePool::KeyType type) {
+  if (type == CertificatePool::kRSA) {
+    return rtc::KeyParams::RSA(rtc::kRsaDefaultModSize,
+                               rtc::kRsaDefaultExponent);
+  }
+
+  return rtc::KeyParams::ECDSA(rtc::EC_NIST_P256);
+}
+
+CertificatePoolOptions::CertificatePoolOptions()
+    : ecdsa(0),
+      rsa(0) {
+}
+
+CertificatePool::CertificatePool(const CertificatePoolOptions &options)
+    : _thread(rtc::Thread::Create().release()),
+      _refilling(false),
+      _hits(0),
+      _misses(0) {
+  _sizes[kECDSA] = options.ecdsa;
+  _sizes[kRSA] = options.rsa;
+  _thread->SetName(kThreadName, NULL);
+}
+
+CertificatePool::~CertificatePool() {
+  // Waits for the certificate being generated, if any.
+  _thread->Clear(this, kRefill);
+  _thread->Stop();
+  delete _thread;
+}
+
+bool CertificatePool::Start() {
+  if (!_thread->Start()) {
+    return false;
+  }
+
+  rtc::CritScope lock(&_lock);
+  ScheduleRefill();
+  return true;
+}
+
+bool CertificatePool::GetKeyType(const rtc::KeyParams &keyParams,
+                                 KeyType *type) {
+  if (keyParams.type() == rtc::KT_ECDSA &&
+      keyParams.ec_curve() == rtc::EC_NIST_P256) {
+    *type = kECDSA;
+    return true;
+  }
+
+  if (keyParams.type() == rtc::KT_RSA &&
+      keyParams.rsa_params().mod_size == rtc::kRsaDefaultModSize &&
+      keyParams.rsa_params().pub_exp == rtc::kRsaDefaultExponent) {
+    *type = kRSA;
+    return true;
+  }
+
+  return false;
+}
+
+rtc::scoped_refptr<rtc::RTCCertificate> CertificatePool::Take(
+    KeyType type) {
+  rtc::CritScope lock(&_lock);
+  std::deque<rtc::scoped_refptr<rtc::RTCCertificate> > &certificates =
+      _certificates[type];
+  uint64_t now = RTCCertificate::Now();
+
+  // Certificates may have waited in the pool for a while.
+  while (!certificates.empty() && certificates.front()->HasExpired(now)) {
+    certificates.pop_front();
+  }
+
+  if (certificates.empty()) {
+    if (_sizes[type]) {
+      ++_misses;
+    }
+
+    return NULL;
+  }
+
+  rtc::scoped_refptr<rtc::RTCCertificate> certificate = certificates.front();
+  certificates.pop_front();
+  ++_hits;
+
+  ScheduleRefill();
+  return certificate;
+}
+
+CertificatePoolStats CertificatePool::GetStats() {
+  rtc::CritScope lock(&_lock);
+  CertificatePoolStats stats = {
+    _hits,
+    _misses,
+    static_cast<uint32_t>(_certificates[kECDSA].size()),
+    static_cast<uint32_t>(_certificates[kRSA].size()),
+  };
+
+  return stats;
+}
+
+void CertificatePool::ScheduleRefill() {
+  if (_refilling) {
+    return;
+  }
+
+  for (int i = 0; i < kKeyTypeCount; ++i) {
+    if (_certificates[i].size() < _sizes[i]) {
+      _refilling = true;
+      _thread->Post(RTC_FROM_HERE, this, kRefill);
+      return;
+    }
+  }
+}
+
+void CertificatePool::OnMessage(rtc::Message *msg) {
+  int type = -1;
+
+  {
+    rtc::CritScope lock(&_lock);
+
+    // The emptiest pool first, relative to its size.
+    for (int i = 0; i < kKeyTypeCount; ++i) {
+      if (_certificates[i].size() >= _sizes[i]) {
+        continue;
+      }
+
+      if (type < 0 || _certificates[i].size() * _sizes[type] <
+                      _certificates[type].size() * _sizes[i]) {
+        type = i;
+      }
+    }
+
+    if (type < 0) {
+      _refilling = false;
+      return;
+    }
+  }
+
+  // Generated outside the lock, Take() is called from the main thread.
+  rtc::scoped_refptr<rtc::RTCCertificate> certificate =
+      rtc::RTCCertificateGenerator::GenerateCertificate(
+          GetKeyParams(static_cast<KeyType>(type)),
+          rtc::Optional<uint64_t>());
+
+  rtc::CritScope lock(&_lock);
+  _refilling = false;
+
+  // A failure is retried on the next Take().
+  if (certificate.get()) {
+    _certificates[type].push_back(certificate);
+    ScheduleRefill();
+  }
+}
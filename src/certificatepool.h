@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CERTIFICATEPOOL_H_
+#define CERTIFICATEPOOL_H_
+
+#include <webrtc/base/criticalsection.h>
+#include <webrtc/base/messagehandler.h>
+#include <webrtc/base/rtccertificate.h>
+#include <webrtc/base/sslidentity.h>
+#include <webrtc/base/thread.h>
+#include <cstdint>
+#include <deque>
+
+struct CertificatePoolOptions {
+  CertificatePoolOptions();
+
+  // Number of certificates kept ready, zero disables that key type.
+  uint32_t ecdsa;
+  uint32_t rsa;
+};
+
+struct CertificatePoolStats {
+  uint64_t hits;
+  uint64_t misses;
+  uint32_t ecdsa;
+  uint32_t rsa;
+};
+
+// Keeps ECDSA P-256 and RSA 2048 certificates ready for generateCertificate()
+// and new connections. Taken certificates are replaced in the background, one
+// at a time, on a thread owned by the pool so that key generation never
+// stalls the WebRTC threads.
+class CertificatePool : public rtc::MessageHandler {
+ public:
+  enum KeyType {
+    kECDSA,
+    kRSA,
+    kKeyTypeCount,
+  };
+
+  explicit CertificatePool(const CertificatePoolOptions &options);
+  ~CertificatePool();
+
+  bool Start();
+
+  // Returns the pooled key type matching the parameters, if any.
+  static bool GetKeyType(const rtc::KeyParams &keyParams, KeyType *type);
+
+  // Returns NULL when no certificate of that type is ready. Any thread.
+  rtc::scoped_refptr<rtc::RTCCertificate> Take(KeyType type);
+
+  CertificatePoolStats GetStats();
+
+  void OnMessage(rtc::Message *msg);
+
+ private:
+  void ScheduleRefill();
+
+  rtc::Thread *_thread;
+  uint32_t _sizes[kKeyTypeCount];
+
+  rtc::CriticalSection _lock;
+  std::deque<rtc::scoped_refptr<rtc::RTCCertificate> >
+      _certificates[kKeyTypeCount];
+  bool _refilling;
+  uint64_t _hits;
+  uint64_t _misses;
+};
+
+#endif  // CERTIFICATEPOOL_H_
@@ -0,0 +1,377 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef WIN32
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include "certificatestore.h"
+#include "event/certificatestoreevent.h"
+#include "paralleljob.h"
+#include "rtccertificate.h"
+
+static const char kMagic[] = "WRTCCERT";
+static const size_t kMagicSize = sizeof(kMagic) - 1;
+static const uint32_t kVersion = 1;
+static const size_t kHeaderSize = kMagicSize + 2 * sizeof(uint32_t);
+static const size_t kEntryHeaderSize = sizeof(uint64_t) + 2 * sizeof(uint32_t);
+
+static const char eOpen[] = "Failed to open the certificate store.";
+static const char eCorrupted[] = "The certificate store is corrupted.";
+static const char eWrite[] = "Failed to write the certificate store.";
+
+static uint32_t ReadUint32(const uint8_t *data) {
+  return static_cast<uint32_t>(data[0]) |
+         static_cast<uint32_t>(data[1]) << 8 |
+         static_cast<uint32_t>(data[2]) << 16 |
+         static_cast<uint32_t>(data[3]) << 24;
+}
+
+static uint64_t ReadUint64(const uint8_t *data) {
+  return static_cast<uint64_t>(ReadUint32(data)) |
+         static_cast<uint64_t>(ReadUint32(data + 4)) << 32;
+}
+
+static void WriteUint32(std::string *out, uint32_t value) {
+  for (int i = 0; i < 4; ++i) {
+    out->push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+  }
+}
+
+static void WriteUint64(std::string *out, uint64_t value) {
+  WriteUint32(out, static_cast<uint32_t>(value));
+  WriteUint32(out, static_cast<uint32_t>(value >> 32));
+}
+
+static void WriteHeader(std::string *out, uint32_t count) {
+  out->append(kMagic, kMagicSize);
+  WriteUint32(out, kVersion);
+  WriteUint32(out, count);
+}
+
+// Writes to a temporary file first, so that a crash never leaves a
+// truncated store behind.
+static bool WriteFile(const std::string &path, const std::string &data) {
+  std::string temporaryPath = path + ".tmp";
+  FILE *file = fopen(temporaryPath.c_str(), "wb");
+
+  if (!file) {
+    return false;
+  }
+
+  bool written = fwrite(data.data(), 1, data.size(), file) == data.size();
+
+  if (fclose(file) || !written) {
+    remove(temporaryPath.c_str());
+    return false;
+  }
+
+#ifdef WIN32
+  remove(path.c_str());
+#endif
+
+  return !rename(temporaryPath.c_str(), path.c_str());
+}
+
+class MappedFile {
+ public:
+  MappedFile() : _data(NULL), _size(0) {}
+
+  ~MappedFile() {
+#ifndef WIN32
+    if (_data) {
+      munmap(const_cast<uint8_t *>(_data), _size);
+    }
+#endif
+  }
+
+  bool Open(const std::string &path) {
+#ifdef WIN32
+    std::ifstream file(path.c_str(), std::ios::binary);
+
+    if (!file) {
+      return false;
+    }
+
+    _buffer.assign(std::istreambuf_iterator<char>(file),
+                   std::istreambuf_iterator<char>());
+    _data = reinterpret_cast<const uint8_t *>(_buffer.data());
+    _size = _buffer.size();
+    return true;
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+
+    if (fd < 0) {
+      return false;
+    }
+
+    struct stat info;
+
+    if (fstat(fd, &info) || !info.st_size) {
+      close(fd);
+      return false;
+    }
+
+    void *data = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED) {
+      return false;
+    }
+
+    _data = static_cast<const uint8_t *>(data);
+    _size = info.st_size;
+    return true;
+#endif
+  }
+
+  const uint8_t *data() const { return _data; }
+  size_t size() const { return _size; }
+
+ private:
+  const uint8_t *_data;
+  size_t _size;
+
+#ifdef WIN32
+  std::string _buffer;
+#endif
+};
+
+class LoadCertificatesJob : public ParallelJob {
+ public:
+  LoadCertificatesJob(const std::string &path,
+                      Local<Promise::Resolver> resolver)
+      : _path(path),
+        _event(new CertificateStoreEvent(resolver, true)),
+        _expired(0),
+        _failed(false) {
+  }
+
+ protected:
+  size_t Prepare() {
+    if (!_file.Open(_path)) {
+      _error = eOpen;
+      return 0;
+    }
+
+    const uint8_t *data = _file.data();
+    const size_t size = _file.size();
+
+    if (size < kHeaderSize || memcmp(data, kMagic, kMagicSize) ||
+        ReadUint32(data + kMagicSize) != kVersion) {
+      _error = eCorrupted;
+      return 0;
+    }
+
+    uint32_t count = ReadUint32(data + kMagicSize + sizeof(uint32_t));
+    uint64_t now = RTCCertificate::Now();
+    size_t offset = kHeaderSize;
+
+    for (uint32_t i = 0; i < count; ++i) {
+      if (size - offset < kEntryHeaderSize) {
+        _error = eCorrupted;
+        return 0;
+      }
+
+      Entry entry;
+      entry.begin = offset;
+      entry.expires = ReadUint64(data + offset);
+      entry.privateKeyLength = ReadUint32(data + offset + 8);
+      entry.certificateLength = ReadUint32(data + offset + 12);
+      offset += kEntryHeaderSize;
+
+      if (size - offset < entry.privateKeyLength ||
+          size - offset - entry.privateKeyLength < entry.certificateLength) {
+        _error = eCorrupted;
+        return 0;
+      }
+
+      entry.privateKey = offset;
+      entry.certificate = offset + entry.privateKeyLength;
+      offset += entry.privateKeyLength + entry.certificateLength;
+      entry.end = offset;
+      entry.expired = entry.expires <= now;
+
+      if (entry.expired) {
+        ++_expired;
+      }
+
+      _entries.push_back(entry);
+    }
+
+    _certificates.resize(_entries.size());
+    return _entries.size();
+  }
+
+  void Run(size_t begin, size_t end) {
+    const char *data = reinterpret_cast<const char *>(_file.data());
+
+    for (size_t i = begin; i < end; ++i) {
+      const Entry &entry = _entries[i];
+
+      if (entry.expired) {
+        continue;
+      }
+
+      rtc::RTCCertificatePEM pem(
+          std::string(data + entry.privateKey, entry.privateKeyLength),
+          std::string(data + entry.certificate, entry.certificateLength));
+      _certificates[i] = rtc::RTCCertificate::FromPEM(pem);
+
+      if (!_certificates[i].get()) {
+        _failed = true;
+      }
+    }
+  }
+
+  void Finish() {
+    if (_error.empty() && _failed) {
+      _error = eCorrupted;
+    }
+
+    if (!_error.empty()) {
+      _event->SetError(_error);
+    } else {
+      // Rotates the expired entries out, copying the others as they are.
+      if (_expired) {
+        std::string data;
+        WriteHeader(&data, static_cast<uint32_t>(_entries.size() - _expired));
+
+        for (size_t i = 0; i < _entries.size(); ++i) {
+          if (!_entries[i].expired) {
+            data.append(
+                reinterpret_cast<const char *>(_file.data()) +
+                    _entries[i].begin,
+                _entries[i].end - _entries[i].begin);
+          }
+        }
+
+        WriteFile(_path, data);
+      }
+
+      std::vector<rtc::scoped_refptr<rtc::RTCCertificate> > certificates;
+      certificates.reserve(_entries.size() - _expired);
+
+      for (size_t i = 0; i < _certificates.size(); ++i) {
+        if (_certificates[i].get()) {
+          certificates.push_back(_certificates[i]);
+        }
+      }
+
+      _event->SetCertificates(&certificates);
+    }
+
+    GetEventQueue()->PushEvent(_event);
+  }
+
+ private:
+  struct Entry {
+    size_t begin;
+    size_t end;
+    uint64_t expires;
+    size_t privateKey;
+    uint32_t privateKeyLength;
+    size_t certificate;
+    uint32_t certificateLength;
+    bool expired;
+  };
+
+  const std::string _path;
+  CertificateStoreEvent *_event;
+  MappedFile _file;
+  std::string _error;
+  std::vector<Entry> _entries;
+  std::vector<rtc::scoped_refptr<rtc::RTCCertificate> > _certificates;
+  size_t _expired;
+  std::atomic<bool> _failed;
+};
+
+class SaveCertificatesJob : public ParallelJob {
+ public:
+  SaveCertificatesJob(
+      const std::string &path,
+      const std::vector<rtc::scoped_refptr<rtc::RTCCertificate> >
+          &certificates,
+      Local<Promise::Resolver> resolver)
+      : _path(path),
+        _certificates(certificates),
+        _event(new CertificateStoreEvent(resolver, false)) {
+  }
+
+ protected:
+  size_t Prepare() {
+    _privateKeys.resize(_certificates.size());
+    _pems.resize(_certificates.size());
+    return _certificates.size();
+  }
+
+  void Run(size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      rtc::RTCCertificatePEM pem = _certificates[i]->ToPEM();
+      _privateKeys[i] = pem.private_key();
+      _pems[i] = pem.certificate();
+    }
+  }
+
+  void Finish() {
+    std::string data;
+    WriteHeader(&data, static_cast<uint32_t>(_certificates.size()));
+
+    for (size_t i = 0; i < _certificates.size(); ++i) {
+      WriteUint64(&data, _certificates[i]->Expires());
+      WriteUint32(&data, static_cast<uint32_t>(_privateKeys[i].size()));
+      WriteUint32(&data, static_cast<uint32_t>(_pems[i].size()));
+      data.append(_privateKeys[i]);
+      data.append(_pems[i]);
+    }
+
+    if (!WriteFile(_path, data)) {
+      _event->SetError(eWrite);
+    }
+
+    GetEventQueue()->PushEvent(_event);
+  }
+
+ private:
+  const std::string _path;
+  const std::vector<rtc::scoped_refptr<rtc::RTCCertificate> > _certificates;
+  CertificateStoreEvent *_event;
+  std::vector<std::string> _privateKeys;
+  std::vector<std::string> _pems;
+};
+
+void CertificateStore::Load(const std::string &path,
+                            Local<Promise::Resolver> resolver) {
+  (new LoadCertificatesJob(path, resolver))->Start();
+}
+
+void CertificateStore::Save(
+    const std::string &path,
+    const std::vector<rtc::scoped_refptr<rtc::RTCCertificate> >
+        &certificates,
+    Local<Promise::Resolver> resolver) {
+  (new SaveCertificatesJob(path, certificates, resolver))->Start();
+}
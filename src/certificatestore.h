@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CERTIFICATESTORE_H_
+#define CERTIFICATESTORE_H_
+
+#include <nan.h>
+#include <webrtc/base/rtccertificate.h>
+#include <string>
+#include <vector>
+
+using namespace v8;
+
+// Saves many certificates to a single file and loads them back in bulk. The
+// file is read through a memory mapping and its entries are parsed in
+// parallel on the libuv threadpool, the main thread only wraps the results.
+//
+// Layout, little-endian: the "WRTCCERT" magic, a uint32 version and a uint32
+// count, then for each certificate a uint64 expiration time in milliseconds
+// since the epoch, the uint32 lengths of the PEM private key and
+// certificate, and both PEM strings.
+class CertificateStore {
+ public:
+  // Resolves with the certificates of the file, in order. Expired entries
+  // are skipped, and removed from the file.
+  static void Load(const std::string &path,
+                   Local<Promise::Resolver> resolver);
+
+  // Resolves once the file has been replaced.
+  static void Save(
+      const std::string &path,
+      const std::vector<rtc::scoped_refptr<rtc::RTCCertificate> >
+          &certificates,
+      Local<Promise::Resolver> resolver);
+};
+
+#endif  // CERTIFICATESTORE_H_
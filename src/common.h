@@ -17,6 +17,7 @@
 #ifndef COMMON_H_
 #define COMMON_H_
 
+#include <cmath>
 #include <sstream>
 #include <webrtc/base/logging.h>
 
@@ -38,6 +39,9 @@
 #define ERROR_PROPERTY_NOT_A_NUMBER(NAME) \
   "The '" << NAME << "' property is not a number."
 
+#define ERROR_PROPERTY_NOT_INTEGER(NAME) \
+  "The '" << NAME << "' property is not an integer."
+
 #define ERROR_PROPERTY_NOT_STRING(NAME) \
   "The '" << NAME << "' property is not a string, or is empty."
 
@@ -47,6 +51,12 @@
 #define ERROR_PROPERTY_NOT_UINT8ARRAY(NAME) \
   "The '" << NAME << "' property is not a Uint8Array."
 
+#define ERROR_PROPERTY_NOT_OBJECT(NAME) \
+  "The '" << NAME << "' property is not an object."
+
+#define ERROR_PROPERTY_OUT_OF_RANGE(NAME) \
+  "The '" << NAME << "' property is out of range."
+
 #define ERROR_PROPERTY_NOT_DEFINED(NAME) \
   "The '" << NAME << "' property is undefined."
 
@@ -152,6 +162,15 @@
   \
   Local<Number> S(V->ToNumber());
 
+// NaN and fractions would otherwise be truncated by Uint32Value().
+#define ASSERT_PROPERTY_INTEGER(N, V, S) \
+  ASSERT_PROPERTY_NUMBER(N, V, S) \
+  \
+  if (S->Value() != std::floor(S->Value())) { \
+    errorStream << ERROR_PROPERTY_NOT_INTEGER(N); \
+    return Nan::ThrowTypeError(errorStream.str().c_str()); \
+  }
+
 #define ASSERT_PROPERTY_STRING(N, V, S) \
   if (!V->IsString()) { \
     errorStream << ERROR_PROPERTY_NOT_STRING(N); \
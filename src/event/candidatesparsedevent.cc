@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "candidatesparsedevent.h"
+#include "common.h"
+#include "rtcicecandidate.h"
+
+CandidatesParsedEvent::CandidatesParsedEvent(
+    Local<Promise::Resolver> resolver)
+    : _resolver(resolver) {
+}
+
+void CandidatesParsedEvent::Handle() {
+  Nan::HandleScope scope;
+  Local<Promise::Resolver> resolver = Nan::New(_resolver);
+  Local<Array> candidates = Nan::New<Array>(_candidates.size());
+
+  for (uint32_t i = 0; i < _candidates.size(); ++i) {
+    if (_errors[i].empty()) {
+      Nan::Set(candidates, i, RTCIceCandidate::Create(_candidates[i]));
+      continue;
+    }
+
+    std::string error(ERROR_CONSTRUCT_PREFIX("RTCIceCandidate"));
+    error += _errors[i];
+    Nan::Set(candidates, i, Nan::Error(error.c_str()));
+  }
+
+  resolver->Resolve(candidates);
+  _resolver.Reset();
+}
+
+void CandidatesParsedEvent::SetResults(
+    std::vector<CandidateInfo> *candidates,
+    std::vector<std::string> *errors) {
+  _candidates.swap(*candidates);
+  _errors.swap(*errors);
+}
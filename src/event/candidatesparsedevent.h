@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_CANDIDATESPARSEDEVENT_H_
+#define EVENT_CANDIDATESPARSEDEVENT_H_
+
+#include <nan.h>
+#include <string>
+#include <vector>
+#include "candidateinfo.h"
+#include "eventpool.h"
+
+using namespace v8;
+
+// Settles the promise of RTCIceCandidate.parseMany().
+class CandidatesParsedEvent : public PooledEvent<CandidatesParsedEvent> {
+ public:
+  explicit CandidatesParsedEvent(Local<Promise::Resolver> resolver);
+
+  void Handle();
+
+  // An empty error marks a successfully parsed candidate.
+  void SetResults(std::vector<CandidateInfo> *candidates,
+                  std::vector<std::string> *errors);
+
+ private:
+  Nan::Persistent<Promise::Resolver> _resolver;
+  std::vector<CandidateInfo> _candidates;
+  std::vector<std::string> _errors;
+};
+
+#endif  // EVENT_CANDIDATESPARSEDEVENT_H_
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "certificatestoreevent.h"
+#include "common.h"
+#include "rtccertificate.h"
+
+CertificateStoreEvent::CertificateStoreEvent(
+    Local<Promise::Resolver> resolver, bool load)
+    : _resolver(resolver),
+      _load(load) {
+}
+
+void CertificateStoreEvent::Handle() {
+  Nan::HandleScope scope;
+  Local<Promise::Resolver> resolver = Nan::New(_resolver);
+
+  if (!_error.empty()) {
+    resolver->Reject(Nan::Error(_error.c_str()));
+  } else if (_load) {
+    Local<Array> certificates = Nan::New<Array>(_certificates.size());
+
+    for (uint32_t i = 0; i < _certificates.size(); ++i) {
+      Nan::Set(certificates, i, RTCCertificate::Create(_certificates[i]));
+    }
+
+    resolver->Resolve(certificates);
+  } else {
+    resolver->Resolve(Nan::Undefined());
+  }
+
+  _resolver.Reset();
+}
+
+void CertificateStoreEvent::SetError(const std::string &error) {
+  _error = error;
+}
+
+void CertificateStoreEvent::SetCertificates(
+    std::vector<rtc::scoped_refptr<rtc::RTCCertificate> > *certificates) {
+  _certificates.swap(*certificates);
+}
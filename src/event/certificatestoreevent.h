@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_CERTIFICATESTOREEVENT_H_
+#define EVENT_CERTIFICATESTOREEVENT_H_
+
+#include <nan.h>
+#include <webrtc/base/rtccertificate.h>
+#include <string>
+#include <vector>
+#include "eventpool.h"
+
+using namespace v8;
+
+// Settles the promise of RTCCertificate.load() or RTCCertificate.save().
+class CertificateStoreEvent : public PooledEvent<CertificateStoreEvent> {
+ public:
+  CertificateStoreEvent(Local<Promise::Resolver> resolver, bool load);
+
+  void Handle();
+
+  void SetError(const std::string &error);
+  void SetCertificates(
+      std::vector<rtc::scoped_refptr<rtc::RTCCertificate> > *certificates);
+
+ private:
+  Nan::Persistent<Promise::Resolver> _resolver;
+  bool _load;
+  std::string _error;
+  std::vector<rtc::scoped_refptr<rtc::RTCCertificate> > _certificates;
+};
+
+#endif  // EVENT_CERTIFICATESTOREEVENT_H_
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <nan.h>
+#include "channelbufferedamountevent.h"
+#include "common.h"
+#include "rtcdatachannel.h"
+#include "stringtable.h"
+
+ChannelBufferedAmountEvent::ChannelBufferedAmountEvent(
+    DataChannelObserver *observer, uint64_t drained)
+    : PooledEvent(observer),
+      _drained(drained) {
+}
+
+void ChannelBufferedAmountEvent::Handle() {
+  RTCDataChannel *target = GetTarget();
+
+  if (!target || !target->DrainBufferedAmount(_drained)) {
+    return;
+  }
+
+  Nan::HandleScope scope;
+  Local<Object> event = Nan::New<Object>();
+
+  event->Set(StringTable::Get(kStringType),
+             StringTable::Get(kStringBufferedAmountLow));
+  target->Dispatch(kStringOnBufferedAmountLow, event);
+}
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_CHANNELBUFFEREDAMOUNTEVENT_H_
+#define EVENT_CHANNELBUFFEREDAMOUNTEVENT_H_
+
+#include <cstdint>
+#include "channelevent.h"
+#include "eventpool.h"
+
+// Carries the number of queued bytes a data channel handed to its transport.
+// RTCDataChannel mirrors bufferedAmount on the main thread and fires
+// onbufferedamountlow when it falls to bufferedAmountLowThreshold.
+class ChannelBufferedAmountEvent :
+    public PooledEvent<ChannelBufferedAmountEvent, ChannelEvent> {
+ public:
+  ChannelBufferedAmountEvent(DataChannelObserver *observer, uint64_t drained);
+
+  void Handle();
+
+ private:
+  uint64_t _drained;
+};
+
+#endif  // EVENT_CHANNELBUFFEREDAMOUNTEVENT_H_
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_CHANNELEVENT_H_
+#define EVENT_CHANNELEVENT_H_
+
+#include <webrtc/base/scoped_ref_ptr.h>
+#include "event.h"
+
+class DataChannelObserver;
+class RTCDataChannel;
+
+// Base class for events raised by a DataChannelObserver, keeping the
+// observer alive until the event has been handled on the main thread.
+class ChannelEvent : public Event {
+ public:
+  explicit ChannelEvent(DataChannelObserver *observer);
+  ~ChannelEvent();
+
+ protected:
+  // Returns NULL once the RTCDataChannel wrapper is gone.
+  RTCDataChannel *GetTarget() const;
+
+  DataChannelObserver *GetObserver() const;
+
+ private:
+  rtc::scoped_refptr<DataChannelObserver> _observer;
+};
+
+#endif  // EVENT_CHANNELEVENT_H_
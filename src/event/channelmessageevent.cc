@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <nan.h>
+#include "channelmessageevent.h"
+#include "common.h"
+#include "rtcdatachannel.h"
+#include "stringtable.h"
+
+ChannelMessageEvent::ChannelMessageEvent(DataChannelObserver *observer,
+                                         const webrtc::DataBuffer &buffer)
+    : PooledEvent(observer),
+      _data(buffer.data),
+      _binary(buffer.binary) {
+}
+
+void ChannelMessageEvent::Handle() {
+  RTCDataChannel *target = GetTarget();
+
+  if (!target) {
+    return;
+  }
+
+  Nan::HandleScope scope;
+  Local<Value> data;
+
+  if (_binary) {
+    data = RTCDataChannel::WrapBuffer(_data, target->GetBinaryType());
+  } else {
+    const rtc::CopyOnWriteBuffer &view = _data;
+    data = Nan::New<String>(view.data<char>(), view.size()).ToLocalChecked();
+  }
+
+  Local<Object> event = Nan::New<Object>();
+  event->Set(StringTable::Get(kStringType), StringTable::Get(kStringMessage));
+  event->Set(StringTable::Get(kStringData), data);
+
+  target->Dispatch(kStringOnMessage, event);
+}
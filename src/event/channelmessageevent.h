@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_CHANNELMESSAGEEVENT_H_
+#define EVENT_CHANNELMESSAGEEVENT_H_
+
+#include <webrtc/api/datachannelinterface.h>
+#include <webrtc/base/copyonwritebuffer.h>
+#include "channelevent.h"
+#include "eventpool.h"
+
+// A message received on a data channel. The payload is shared with the
+// DataBuffer handed out by the SCTP transport, and binary payloads are given
+// to JavaScript as externally backed buffers: the bytes are never copied
+// between the network and the onmessage handler.
+class ChannelMessageEvent :
+    public PooledEvent<ChannelMessageEvent, ChannelEvent> {
+ public:
+  ChannelMessageEvent(DataChannelObserver *observer,
+                      const webrtc::DataBuffer &buffer);
+
+  void Handle();
+
+ private:
+  rtc::CopyOnWriteBuffer _data;
+  bool _binary;
+};
+
+#endif  // EVENT_CHANNELMESSAGEEVENT_H_
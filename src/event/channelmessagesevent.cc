@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <nan.h>
+#include <cstring>
+#include "channelmessagesevent.h"
+#include "common.h"
+#include "observer/datachannelobserver.h"
+#include "rtcdatachannel.h"
+#include "stringtable.h"
+
+ChannelMessagesEvent::ChannelMessagesEvent(DataChannelObserver *observer)
+    : PooledEvent(observer) {
+}
+
+ChannelMessagesEvent::~ChannelMessagesEvent() {
+  GetObserver()->DetachBatch(this);
+}
+
+void ChannelMessagesEvent::Append(const webrtc::DataBuffer &buffer) {
+  _offsets.push_back(static_cast<uint32_t>(_data.size()));
+  _binary.push_back(buffer.binary);
+  _data.AppendData(buffer.data);
+}
+
+void ChannelMessagesEvent::Handle() {
+  // From now on the observer starts a new batch, this one is ours.
+  GetObserver()->DetachBatch(this);
+
+  RTCDataChannel *target = GetTarget();
+
+  if (!target) {
+    return;
+  }
+
+  Nan::HandleScope scope;
+  size_t count = _offsets.size();
+
+  // offsets[i] and offsets[i + 1] delimit the i-th message.
+  Local<ArrayBuffer> offsetsBuffer = ArrayBuffer::New(
+      Isolate::GetCurrent(), (count + 1) * sizeof(uint32_t));
+  Local<Uint32Array> offsets = Uint32Array::New(offsetsBuffer, 0, count + 1);
+  uint32_t *offsetsData = static_cast<uint32_t *>(
+      offsetsBuffer->GetContents().Data());
+  memcpy(offsetsData, _offsets.data(), count * sizeof(uint32_t));
+  offsetsData[count] = static_cast<uint32_t>(_data.size());
+
+  Local<ArrayBuffer> binaryBuffer = ArrayBuffer::New(Isolate::GetCurrent(),
+                                                     count);
+  Local<Uint8Array> binary = Uint8Array::New(binaryBuffer, 0, count);
+  memcpy(binaryBuffer->GetContents().Data(), _binary.data(), count);
+
+  Local<Object> event = Nan::New<Object>();
+  event->Set(StringTable::Get(kStringType), StringTable::Get(kStringMessages));
+  event->Set(StringTable::Get(kStringData),
+             RTCDataChannel::WrapBuffer(_data, target->GetBinaryType()));
+  event->Set(StringTable::Get(kStringOffsets), offsets);
+  event->Set(StringTable::Get(kStringBinary), binary);
+
+  target->Dispatch(kStringOnMessages, event);
+}
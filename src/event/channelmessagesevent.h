@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_CHANNELMESSAGESEVENT_H_
+#define EVENT_CHANNELMESSAGESEVENT_H_
+
+#include <webrtc/api/datachannelinterface.h>
+#include <webrtc/base/copyonwritebuffer.h>
+#include <cstdint>
+#include <vector>
+#include "channelevent.h"
+#include "eventpool.h"
+
+// Messages received on a data channel in batch mode. The observer keeps
+// appending to the same event until the main thread starts handling it, so
+// every message received between two EventQueue flushes ends up in a single
+// contiguous buffer, along with an offset table, and a single onmessages
+// call.
+class ChannelMessagesEvent :
+    public PooledEvent<ChannelMessagesEvent, ChannelEvent> {
+ public:
+  explicit ChannelMessagesEvent(DataChannelObserver *observer);
+  ~ChannelMessagesEvent();
+
+  void Handle();
+
+  // Called by the observer, with its batch lock held.
+  void Append(const webrtc::DataBuffer &buffer);
+
+ private:
+  rtc::CopyOnWriteBuffer _data;
+  std::vector<uint32_t> _offsets;
+  std::vector<uint8_t> _binary;
+};
+
+#endif  // EVENT_CHANNELMESSAGESEVENT_H_
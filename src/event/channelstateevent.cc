@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <nan.h>
+#include "channelstateevent.h"
+#include "common.h"
+#include "rtcdatachannel.h"
+#include "stringtable.h"
+
+ChannelStateEvent::ChannelStateEvent(
+    DataChannelObserver *observer,
+    webrtc::DataChannelInterface::DataState state, int id)
+    : PooledEvent(observer),
+      _state(state),
+      _id(id) {
+}
+
+void ChannelStateEvent::Handle() {
+  RTCDataChannel *target = GetTarget();
+
+  if (!target) {
+    return;
+  }
+
+  target->SetState(_state, _id);
+
+  Nan::HandleScope scope;
+  Local<Object> event = Nan::New<Object>();
+
+  switch (_state) {
+    case webrtc::DataChannelInterface::kOpen:
+      event->Set(StringTable::Get(kStringType), StringTable::Get(kStringOpen));
+      target->Dispatch(kStringOnOpen, event);
+      break;
+
+    case webrtc::DataChannelInterface::kClosed:
+      event->Set(StringTable::Get(kStringType), StringTable::Get(kStringClose));
+      target->Dispatch(kStringOnClose, event);
+      break;
+
+    default:
+      break;
+  }
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_CHANNELSTATEEVENT_H_
+#define EVENT_CHANNELSTATEEVENT_H_
+
+#include <webrtc/api/datachannelinterface.h>
+#include "channelevent.h"
+#include "eventpool.h"
+
+class ChannelStateEvent : public PooledEvent<ChannelStateEvent, ChannelEvent> {
+ public:
+  ChannelStateEvent(DataChannelObserver *observer,
+                    webrtc::DataChannelInterface::DataState state, int id);
+
+  void Handle();
+
+ private:
+  webrtc::DataChannelInterface::DataState _state;
+  int _id;
+};
+
+#endif  // EVENT_CHANNELSTATEEVENT_H_
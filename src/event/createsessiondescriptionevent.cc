@@ -17,79 +17,71 @@
 #include "common.h"
 #include "createsessiondescriptionevent.h"
 #include "rtcsessiondescription.h"
+#include "stringtable.h"
 
 using namespace v8;
 
+static const char kName[] = "name";
+
 CreateSessionDescriptionEvent::CreateSessionDescriptionEvent(
-    Persistent<Function> *successCallback,
-    Persistent<Function> *failureCallback) :
-    _resolver(NULL),
+    Local<Function> successCallback,
+    Local<Function> failureCallback) :
     _successCallback(successCallback),
     _failureCallback(failureCallback) {
 }
 
 CreateSessionDescriptionEvent::CreateSessionDescriptionEvent(
-    Persistent<Promise::Resolver> *resolver) :
-    _resolver(resolver),
-    _successCallback(NULL),
-    _failureCallback(NULL) {
+    Local<Promise::Resolver> resolver) :
+    _resolver(resolver) {
 }
 
 void CreateSessionDescriptionEvent::Handle() {
   Nan::HandleScope scope;
 
-  if (_resolver) {
-    Local<Promise::Resolver> resolver = Nan::New(*_resolver);
+  if (!_resolver.IsEmpty()) {
+    Local<Promise::Resolver> resolver = Nan::New(_resolver);
 
     if (_succeeded) {
       Local<Object> descriptionInitDict = Nan::New<Object>();
 
-      descriptionInitDict->Set(LOCAL_STRING(RTCSessionDescription::kSdp),
+      descriptionInitDict->Set(StringTable::Get(kStringSdp),
                                LOCAL_STRING(_sdp));
-      descriptionInitDict->Set(LOCAL_STRING(RTCSessionDescription::kType),
-                               LOCAL_STRING(_type));
+      descriptionInitDict->Set(StringTable::Get(kStringType),
+                               RTCSessionDescription::GetTypeString(_type));
 
       resolver->Resolve(descriptionInitDict);
     } else {
-      resolver->Reject(Nan::Error(_errorMessage.c_str()));
+      resolver->Reject(CreateError());
     }
 
-    Isolate::GetCurrent()->RunMicrotasks();
-    _resolver->Reset();
-    delete _resolver;
+    _resolver.Reset();
     return;
   }
 
-  if (_succeeded && _successCallback) {
-    Local<Function> successCallback = Nan::New(*_successCallback);
-    Nan::Callback cb(successCallback);
-
+  if (_succeeded) {
+    Local<Function> successCallback = Nan::New(_successCallback);
     Local<Object> descriptionInitDict = Nan::New<Object>();
 
-    descriptionInitDict->Set(LOCAL_STRING(RTCSessionDescription::kSdp),
+    descriptionInitDict->Set(StringTable::Get(kStringSdp),
                              LOCAL_STRING(_sdp));
-    descriptionInitDict->Set(LOCAL_STRING(RTCSessionDescription::kType),
-                             LOCAL_STRING(_type));
+    descriptionInitDict->Set(StringTable::Get(kStringType),
+                             RTCSessionDescription::GetTypeString(_type));
 
     const int argc = 1;
     Local<Value> argv[1] = { descriptionInitDict };
 
-    cb.Call(argc, argv);
-  } else if (!_succeeded && _failureCallback) {
-    Local<Function> failureCallback = Nan::New(*_failureCallback);
-    Nan::Callback cb(failureCallback);
+    Nan::Call(successCallback, Nan::GetCurrentContext()->Global(), argc, argv);
+  } else {
+    Local<Function> failureCallback = Nan::New(_failureCallback);
 
     const int argc = 1;
-    Local<Value> argv[1] = { Nan::Error(_errorMessage.c_str()) };
+    Local<Value> argv[1] = { CreateError() };
 
-    cb.Call(argc, argv);
+    Nan::Call(failureCallback, Nan::GetCurrentContext()->Global(), argc, argv);
   }
 
-  _successCallback->Reset();
-  _failureCallback->Reset();
-
-  delete _successCallback;
-  delete _failureCallback;
+  _successCallback.Reset();
+  _failureCallback.Reset();
 }
 
 void CreateSessionDescriptionEvent::SetSucceeded(bool succeeded) {
@@ -101,8 +93,23 @@ void CreateSessionDescriptionEvent::SetErrorMessage(
   _errorMessage = errorMessage;
 }
 
+void CreateSessionDescriptionEvent::SetErrorName(const std::string &errorName) {
+  _errorName = errorName;
+}
+
+Local<Value> CreateSessionDescriptionEvent::CreateError() {
+  Local<Value> error = Nan::Error(_errorMessage.c_str());
+
+  if (!_errorName.empty()) {
+    Nan::Set(error.As<Object>(), LOCAL_STRING(kName),
+             LOCAL_STRING(_errorName));
+  }
+
+  return error;
+}
+
 void CreateSessionDescriptionEvent::SetSessionDescription(
-    webrtc::SessionDescriptionInterface *sessionDescription) {
-  _type = sessionDescription->type();
-  sessionDescription->ToString(&_sdp);
+    const std::string &type, const std::string &sdp) {
+  _type = type;
+  _sdp = sdp;
 }
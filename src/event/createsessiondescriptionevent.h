@@ -18,30 +18,35 @@
 #define EVENT_CREATESESSIONDESCRIPTIONEVENT_H_
 
 #include <nan.h>
-#include <webrtc/api/jsep.h>
-#include "event.h"
+#include <string>
+#include "eventpool.h"
 
 using namespace v8;
 
-class CreateSessionDescriptionEvent : public Event {
+class CreateSessionDescriptionEvent :
+    public PooledEvent<CreateSessionDescriptionEvent> {
  public:
   explicit CreateSessionDescriptionEvent(
-      Persistent<Promise::Resolver> *resolver);
-  CreateSessionDescriptionEvent(Persistent<Function> *successCallback,
-                                Persistent<Function> *failureCallback);
+      Local<Promise::Resolver> resolver);
+  CreateSessionDescriptionEvent(Local<Function> successCallback,
+                                Local<Function> failureCallback);
 
   void Handle();
   void SetSucceeded(bool succeeded);
   void SetErrorMessage(const std::string& errorMessage);
-  void SetSessionDescription(
-      webrtc::SessionDescriptionInterface *sessionDescription);
+  // The name given to the Error, "Error" when not set.
+  void SetErrorName(const std::string& errorName);
+  void SetSessionDescription(const std::string& type, const std::string& sdp);
 
  private:
-  Persistent<Promise::Resolver> *_resolver;
-  Persistent<Function> *_successCallback;
-  Persistent<Function> *_failureCallback;
+  Local<Value> CreateError();
+
+  Nan::Persistent<Promise::Resolver> _resolver;
+  Nan::Persistent<Function> _successCallback;
+  Nan::Persistent<Function> _failureCallback;
   bool _succeeded;
   std::string _errorMessage;
+  std::string _errorName;
   std::string _type;
   std::string _sdp;
 };
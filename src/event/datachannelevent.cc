@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <nan.h>
+#include "common.h"
+#include "datachannelevent.h"
+#include "observer/datachannelobserver.h"
+#include "rtcdatachannel.h"
+#include "rtcpeerconnection.h"
+#include "stringtable.h"
+
+DataChannelEvent::DataChannelEvent(PeerConnectionObserver *observer,
+                                   DataChannelObserver *dataChannelObserver)
+    : PooledEvent(observer),
+      _dataChannelObserver(dataChannelObserver) {
+}
+
+DataChannelEvent::~DataChannelEvent() {
+  // Nobody took the channel, the connection is gone.
+  if (_dataChannelObserver.get()) {
+    _dataChannelObserver->Unregister();
+    _dataChannelObserver = NULL;
+  }
+}
+
+void DataChannelEvent::Handle() {
+  RTCPeerConnection *target = GetTarget();
+
+  if (!target) {
+    return;
+  }
+
+  Nan::HandleScope scope;
+  Local<Object> channel = RTCDataChannel::Create(_dataChannelObserver);
+  _dataChannelObserver = NULL;
+
+  Local<Object> event = Nan::New<Object>();
+  event->Set(StringTable::Get(kStringType),
+             StringTable::Get(kStringDataChannel));
+  event->Set(StringTable::Get(kStringChannel), channel);
+
+  target->Dispatch(kStringOnDataChannel, event);
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_DATACHANNELEVENT_H_
+#define EVENT_DATACHANNELEVENT_H_
+
+#include <webrtc/base/scoped_ref_ptr.h>
+#include "eventpool.h"
+#include "peerconnectionevent.h"
+
+class DataChannelObserver;
+
+// Announces a data channel opened by the remote peer. Its observer has
+// already been registered on the signaling thread so that no message can be
+// missed, and is handed to the RTCDataChannel wrapper created by Handle().
+class DataChannelEvent :
+    public PooledEvent<DataChannelEvent, PeerConnectionEvent> {
+ public:
+  DataChannelEvent(PeerConnectionObserver *observer,
+                   DataChannelObserver *dataChannelObserver);
+  ~DataChannelEvent();
+
+  void Handle();
+
+ private:
+  rtc::scoped_refptr<DataChannelObserver> _dataChannelObserver;
+};
+
+#endif  // EVENT_DATACHANNELEVENT_H_
@@ -17,7 +17,9 @@
 #ifndef EVENT_EVENT_H_
 #define EVENT_EVENT_H_
 
-class Event {
+#include "mpscqueue.h"
+
+class Event : public MpscNode {
  public:
   virtual ~Event() {}
 
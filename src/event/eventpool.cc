@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cassert>
+#include <new>
+#include "eventpool.h"
+
+std::atomic<uint64_t> EventPool::_heapAllocations(0);
+std::atomic<uint64_t> EventPool::_pooledAllocations(0);
+std::atomic<uint64_t> EventPool::_releases(0);
+std::atomic<uint64_t> EventPool::_remoteReleases(0);
+
+EventPool::EventPool(size_t size) : _size(size) {
+  static_assert(sizeof(Block) <= kHeaderSize, "Block header is too large");
+  uv_key_create(&_key);
+}
+
+EventPool::ThreadCache *EventPool::GetThreadCache() {
+  ThreadCache *cache = static_cast<ThreadCache*>(uv_key_get(&_key));
+
+  if (!cache) {
+    cache = new ThreadCache();
+    uv_key_set(&_key, cache);
+  }
+
+  return cache;
+}
+
+void *EventPool::Allocate(size_t size) {
+  assert(size <= _size);
+
+  ThreadCache *cache = GetThreadCache();
+
+  if (!cache->local) {
+    cache->local = cache->remote.exchange(NULL, std::memory_order_acquire);
+  }
+
+  Block *block = cache->local;
+
+  if (block) {
+    cache->local = block->next;
+    _pooledAllocations.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    block = static_cast<Block*>(::operator new(kHeaderSize + _size));
+    block->owner = cache;
+    _heapAllocations.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  return reinterpret_cast<char*>(block) + kHeaderSize;
+}
+
+void EventPool::Release(void *ptr) {
+  if (!ptr) {
+    return;
+  }
+
+  Block *block = reinterpret_cast<Block*>(
+      static_cast<char*>(ptr) - kHeaderSize);
+  ThreadCache *owner = block->owner;
+
+  _releases.fetch_add(1, std::memory_order_relaxed);
+
+  if (owner == uv_key_get(&_key)) {
+    block->next = owner->local;
+    owner->local = block;
+    return;
+  }
+
+  _remoteReleases.fetch_add(1, std::memory_order_relaxed);
+  block->next = owner->remote.load(std::memory_order_relaxed);
+
+  while (!owner->remote.compare_exchange_weak(block->next, block,
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed)) {
+  }
+}
+
+EventPoolStats EventPool::GetStats() {
+  EventPoolStats stats;
+
+  stats.heapAllocations = _heapAllocations.load();
+  stats.pooledAllocations = _pooledAllocations.load();
+  stats.releases = _releases.load();
+  stats.remoteReleases = _remoteReleases.load();
+
+  return stats;
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_EVENTPOOL_H_
+#define EVENT_EVENTPOOL_H_
+
+#include <uv.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "event.h"
+
+struct EventPoolStats {
+  uint64_t heapAllocations;
+  uint64_t pooledAllocations;
+  uint64_t releases;
+  uint64_t remoteReleases;
+};
+
+// Fixed-size block allocator with one free list per thread. Blocks released
+// by their owning thread go straight back to its local list; blocks released
+// by another thread (events are usually created on the signaling thread and
+// destroyed on the main thread) are pushed onto the owner's lock-free remote
+// list, which the owner reclaims in one exchange when its local list runs dry.
+// Thread caches are never freed, since blocks may outlive their thread.
+class EventPool {
+ public:
+  explicit EventPool(size_t size);
+
+  void *Allocate(size_t size);
+  void Release(void *ptr);
+
+  static EventPoolStats GetStats();
+
+ private:
+  struct ThreadCache;
+
+  struct Block {
+    Block *next;
+    ThreadCache *owner;
+  };
+
+  struct ThreadCache {
+    ThreadCache() : local(NULL), remote(NULL) {}
+
+    Block *local;
+    std::atomic<Block*> remote;
+  };
+
+  // Keeps the payload suitably aligned for any Event subclass.
+  static const size_t kHeaderSize = 16;
+
+  ThreadCache *GetThreadCache();
+
+  const size_t _size;
+  uv_key_t _key;
+
+  static std::atomic<uint64_t> _heapAllocations;
+  static std::atomic<uint64_t> _pooledAllocations;
+  static std::atomic<uint64_t> _releases;
+  static std::atomic<uint64_t> _remoteReleases;
+};
+
+// Routes allocations of T through a dedicated EventPool. Subclasses derive
+// from PooledEvent<Subclass> (or PooledEvent<Subclass, Base> to keep an
+// intermediate base class) instead of Event.
+template <class T, class Base = Event>
+class PooledEvent : public Base {
+ public:
+  using Base::Base;
+
+  static void *operator new(size_t size) {
+    return Pool().Allocate(size);
+  }
+
+  static void operator delete(void *ptr) {
+    Pool().Release(ptr);
+  }
+
+ private:
+  static EventPool &Pool() {
+    static EventPool pool(sizeof(T));
+    return pool;
+  }
+};
+
+#endif  // EVENT_EVENTPOOL_H_
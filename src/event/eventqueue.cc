@@ -15,23 +15,35 @@
  */
 
 #include <uv.h>
-#include <algorithm>
-#include <iterator>
+#include <webrtc/base/refcount.h>
+#include <webrtc/base/thread.h>
+#include "common.h"
 #include "event.h"
 #include "eventqueue.h"
 
-EventQueue::EventQueue() {
+static const char sEventQueue[] = "webrtc:EventQueue";
+
+EventQueue::EventQueue()
+    : _closed(false),
+      _pushing(0) {
   _async = new uv_async_t;
-  uv_async_init(uv_default_loop(), _async,
+  uv_async_init(Nan::GetCurrentEventLoop(), _async,
                 reinterpret_cast<uv_async_cb>(EventQueue::AsyncCallback));
 
   _async->data = this;
-  uv_mutex_init(&_async_lock);
+
+  _asyncResource = new Nan::AsyncResource(LOCAL_STRING(sEventQueue));
+  _flush.Reset(Nan::GetFunction(Nan::New<v8::FunctionTemplate>(
+      FlushInScope, Nan::New<v8::External>(this))).ToLocalChecked());
 }
 
+// Runs on whichever thread drops the last reference, Close() has already
+// released everything tied to the loop and the isolate.
 EventQueue::~EventQueue() {
-  uv_mutex_destroy(&_async_lock);
-  delete _async;
+}
+
+rtc::scoped_refptr<EventQueue> EventQueue::Create() {
+  return new rtc::RefCountedObject<EventQueue>();
 }
 
 void EventQueue::AsyncCallback(uv_async_t *handle, int status) {
@@ -41,37 +53,84 @@ void EventQueue::AsyncCallback(uv_async_t *handle, int status) {
     return;
   }
 
+  // Every event of the burst is handled within a single callback scope, so
+  // async_hooks see one resource and V8 performs one microtask checkpoint
+  // once all promises are settled, instead of one per event.
+  Nan::HandleScope scope;
+  self->_asyncResource->runInAsyncScope(Nan::GetCurrentContext()->Global(),
+                                        Nan::New(self->_flush), 0, NULL);
+}
+
+NAN_METHOD(EventQueue::FlushInScope) {
+  EventQueue *self =
+      reinterpret_cast<EventQueue*>(info.Data().As<v8::External>()->Value());
+
   self->Flush();
 }
 
 void EventQueue::HandleEvent(Event *event) {
+  Nan::TryCatch tryCatch;
+
   event->Handle();
   delete event;
+
+  if (tryCatch.HasCaught()) {
+    Nan::FatalException(tryCatch);
+  }
 }
 
 void EventQueue::PushEvent(Event *event) {
-  uv_mutex_lock(&_async_lock);
+  // Close() waits for the pushes in flight, so the handle is still open
+  // whenever the flag is seen unset.
+  _pushing.fetch_add(1);
+
+  if (!_closed.load()) {
+    _queue.Push(event);
+    uv_async_send(this->_async);
+    _pushing.fetch_sub(1);
+    return;
+  }
 
-  _queue.push_back(event);
+  _pushing.fetch_sub(1);
 
-  uv_mutex_unlock(&_async_lock);
-  uv_async_send(this->_async);
+  // Deleted on the producer's thread: the destructors only release native
+  // references and return the event to its pool, the handles it holds go
+  // away with their isolate.
+  delete event;
 }
 
 void EventQueue::Flush() {
-  std::vector<Event*> eventList;
+  Event *event;
 
-  uv_mutex_lock(&_async_lock);
+  while ((event = _queue.Pop())) {
+    EventQueue::HandleEvent(event);
+  }
+}
 
-  if (_queue.empty()) {
-    uv_mutex_unlock(&_async_lock);
+void EventQueue::Close() {
+  if (_closed.exchange(true)) {
     return;
   }
 
-  std::copy(_queue.begin(), _queue.end(), std::back_inserter(eventList));
-  _queue.clear();
+  while (_pushing.load()) {
+    rtc::Thread::SleepMs(0);
+  }
+
+  Event *event;
+
+  while ((event = _queue.Pop())) {
+    delete event;
+  }
+
+  _flush.Reset();
+  delete _asyncResource;
+  _asyncResource = NULL;
+
+  _async->data = NULL;
+  uv_close(reinterpret_cast<uv_handle_t *>(_async), CloseCallback);
+  _async = NULL;
+}
 
-  uv_mutex_unlock(&_async_lock);
-  std::for_each(eventList.begin(), eventList.end(), EventQueue::HandleEvent);
-  eventList.clear();
+void EventQueue::CloseCallback(uv_handle_t *handle) {
+  delete reinterpret_cast<uv_async_t *>(handle);
 }
@@ -17,24 +17,51 @@
 #ifndef EVENT_EVENTQUEUE_H_
 #define EVENT_EVENTQUEUE_H_
 
+#include <nan.h>
 #include <uv.h>
-#include <vector>
+#include <webrtc/base/refcount.h>
+#include <webrtc/base/scoped_ref_ptr.h>
+#include <atomic>
+#include "event.h"
+#include "mpscqueue.h"
 
-class Event;
-class EventQueue {
+// Hands events from the WebRTC threads to the event loop of one JavaScript
+// environment, the main thread or a worker. Producers keep a reference to
+// the queue of the environment which owns their target, so that the queue
+// outlives the environment when they still hold it.
+class EventQueue : public rtc::RefCountInterface {
  public:
-  EventQueue();
-  ~EventQueue();
+  // Binds the queue to the event loop of the calling thread.
+  static rtc::scoped_refptr<EventQueue> Create();
 
   static void AsyncCallback(uv_async_t *handle, int status);
   static void HandleEvent(Event *event);
+
+  // May be called from any thread. Once the queue is closed, events are
+  // deleted right away instead of being handled. Producers must not touch
+  // themselves after a push which may drop the last reference to them.
   void PushEvent(Event *event);
   void Flush();
 
+  // Drops the pending events and releases the loop handle. Must be called
+  // from the owning loop, before its environment goes away.
+  void Close();
+
+ protected:
+  EventQueue();
+  ~EventQueue();
+
  private:
+  static NAN_METHOD(FlushInScope);
+  static void CloseCallback(uv_handle_t *handle);
+
   uv_async_t *_async;
-  uv_mutex_t _async_lock;
-  std::vector<Event*> _queue;
+  Nan::AsyncResource *_asyncResource;
+  Nan::Persistent<v8::Function> _flush;
+  MpscQueue<Event> _queue;
+
+  std::atomic<bool> _closed;
+  std::atomic<int> _pushing;
 };
 
 #endif  // EVENT_EVENTQUEUE_H_
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common.h"
+#include "generatecertificateevent.h"
+#include "rtccertificate.h"
+
+using namespace v8;
+
+static const char eFailure[] = "Failed to generate the certificate.";
+
+GenerateCertificateEvent::GenerateCertificateEvent(
+    Local<Promise::Resolver> resolver) :
+    _resolver(resolver) {
+}
+
+void GenerateCertificateEvent::Handle() {
+  Nan::HandleScope scope;
+  Local<Promise::Resolver> resolver = Nan::New(_resolver);
+
+  if (!_certificate.get()) {
+    resolver->Reject(Nan::TypeError(eFailure));
+  } else {
+    resolver->Resolve(RTCCertificate::Create(_certificate));
+  }
+
+  _resolver.Reset();
+}
+
+void GenerateCertificateEvent::SetCertificate(
+    const rtc::scoped_refptr<rtc::RTCCertificate>& certificate) {
+  _certificate = certificate;
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_GENERATECERTIFICATEEVENT_H_
+#define EVENT_GENERATECERTIFICATEEVENT_H_
+
+#include <nan.h>
+#include <webrtc/base/rtccertificate.h>
+#include "eventpool.h"
+
+using namespace v8;
+
+class GenerateCertificateEvent :
+    public PooledEvent<GenerateCertificateEvent> {
+ public:
+  explicit GenerateCertificateEvent(Local<Promise::Resolver> resolver);
+
+  void Handle();
+  void SetCertificate(
+      const rtc::scoped_refptr<rtc::RTCCertificate>& certificate);
+
+ private:
+  Nan::Persistent<Promise::Resolver> _resolver;
+  rtc::scoped_refptr<rtc::RTCCertificate> _certificate;
+};
+
+#endif  // EVENT_GENERATECERTIFICATEEVENT_H_
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common.h"
+#include "getstatsevent.h"
+#include "stringtable.h"
+
+static const char eDetached[] =
+    "The stats array has been detached or resized.";
+
+GetStatsEvent::GetStatsEvent(Local<Promise::Resolver> resolver)
+    : _resolver(resolver),
+      _mode(kModeReport),
+      _offset(0) {
+}
+
+GetStatsEvent::GetStatsEvent(Local<Promise::Resolver> resolver, Mode mode,
+                             Local<Object> array, uint32_t offset)
+    : _resolver(resolver),
+      _array(array),
+      _mode(mode),
+      _offset(offset) {
+}
+
+void GetStatsEvent::SetReport(const webrtc::RTCStatsReport &report) {
+  if (_mode == kModeReport) {
+    CopyStats(report, &_entries);
+  } else {
+    SummarizeStats(report, &_summary);
+  }
+}
+
+static Local<Value> ToValue(const StatsMember &member) {
+  switch (member.type) {
+    case StatsMember::kBool:
+      return Nan::New(member.boolValue);
+
+    case StatsMember::kNumber:
+      return Nan::New(member.numberValue);
+
+    case StatsMember::kString:
+      return LOCAL_STRING(member.stringValue);
+
+    case StatsMember::kBoolSequence: {
+      Local<Array> array = Nan::New<Array>(member.boolValues.size());
+      for (uint32_t i = 0; i < member.boolValues.size(); i++) {
+        Nan::Set(array, i, Nan::New<Boolean>(member.boolValues[i]));
+      }
+      return array;
+    }
+
+    case StatsMember::kNumberSequence: {
+      Local<Array> array = Nan::New<Array>(member.numberValues.size());
+      for (uint32_t i = 0; i < member.numberValues.size(); i++) {
+        Nan::Set(array, i, Nan::New(member.numberValues[i]));
+      }
+      return array;
+    }
+
+    default: {
+      Local<Array> array = Nan::New<Array>(member.stringValues.size());
+      for (uint32_t i = 0; i < member.stringValues.size(); i++) {
+        Nan::Set(array, i, LOCAL_STRING(member.stringValues[i]));
+      }
+      return array;
+    }
+  }
+}
+
+void GetStatsEvent::Handle() {
+  Nan::HandleScope scope;
+  Local<Promise::Resolver> resolver = Nan::New(_resolver);
+
+  if (_mode == kModeReport) {
+    Local<Map> report = Map::New(Isolate::GetCurrent());
+    Local<Context> context = Nan::GetCurrentContext();
+
+    for (size_t i = 0; i < _entries.size(); i++) {
+      const StatsEntry &entry = _entries[i];
+      Local<Object> stats = Nan::New<Object>();
+
+      stats->Set(StringTable::Get(kStringId), LOCAL_STRING(entry.id));
+      stats->Set(StringTable::Get(kStringType), LOCAL_STRING(entry.type));
+      stats->Set(StringTable::Get(kStringTimestamp),
+                 Nan::New(entry.timestampUs / 1000.0));
+
+      for (size_t j = 0; j < entry.members.size(); j++) {
+        stats->Set(LOCAL_STRING(entry.members[j].name),
+                   ToValue(entry.members[j]));
+      }
+
+      report->Set(context, LOCAL_STRING(entry.id), stats).ToLocalChecked();
+    }
+
+    resolver->Resolve(report);
+  } else {
+    Local<TypedArray> array = Nan::New(_array).As<TypedArray>();
+
+    // The bounds were checked by getStats(), but the buffer may have been
+    // transferred since then.
+    if (array->Length() < _offset + kStatsFieldCount) {
+      resolver->Reject(Nan::RangeError(eDetached));
+      _resolver.Reset();
+      _array.Reset();
+      return;
+    }
+
+    char *data = static_cast<char *>(array->Buffer()->GetContents().Data()) +
+        array->ByteOffset();
+
+    if (_mode == kModeFloat64) {
+      _summary.WriteFloat64(reinterpret_cast<double *>(data) + _offset);
+    } else {
+      _summary.WriteUint64(reinterpret_cast<uint64_t *>(data) + _offset);
+    }
+
+    resolver->Resolve(array);
+  }
+
+  _resolver.Reset();
+  _array.Reset();
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_GETSTATSEVENT_H_
+#define EVENT_GETSTATSEVENT_H_
+
+#include <nan.h>
+#include <webrtc/api/stats/rtcstatsreport.h>
+#include <vector>
+#include "eventpool.h"
+#include "stats.h"
+
+using namespace v8;
+
+// Resolves a getStats() promise. In report mode, the whole report is copied
+// and resolved as a Map of stats objects. In compact mode only the counters
+// of the fixed schema are kept, and written straight into the typed array
+// given by the caller.
+class GetStatsEvent : public PooledEvent<GetStatsEvent> {
+ public:
+  enum Mode {
+    kModeReport,
+    kModeFloat64,
+    kModeBigUint64,
+  };
+
+  explicit GetStatsEvent(Local<Promise::Resolver> resolver);
+  GetStatsEvent(Local<Promise::Resolver> resolver, Mode mode,
+                Local<Object> array, uint32_t offset);
+
+  void Handle();
+
+  // Called on the signaling thread.
+  void SetReport(const webrtc::RTCStatsReport &report);
+
+ private:
+  Nan::Persistent<Promise::Resolver> _resolver;
+  Nan::Persistent<Object> _array;
+  Mode _mode;
+  uint32_t _offset;
+
+  StatsSummary _summary;
+  std::vector<StatsEntry> _entries;
+};
+
+#endif  // EVENT_GETSTATSEVENT_H_
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <nan.h>
+#include "common.h"
+#include "icecandidateevent.h"
+#include "rtcicecandidate.h"
+#include "rtcpeerconnection.h"
+#include "stringtable.h"
+
+IceCandidateEvent::IceCandidateEvent(PeerConnectionObserver *observer)
+    : PooledEvent(observer),
+      _hasCandidate(false) {
+}
+
+void IceCandidateEvent::SetCandidate(
+    const webrtc::IceCandidateInterface *candidate) {
+  _hasCandidate = DescribeCandidate(*candidate, &_candidate);
+}
+
+void IceCandidateEvent::Handle() {
+  RTCPeerConnection *target = GetTarget();
+
+  if (!target) {
+    return;
+  }
+
+  Nan::HandleScope scope;
+  Local<Object> event = Nan::New<Object>();
+
+  event->Set(StringTable::Get(kStringType),
+             StringTable::Get(kStringIceCandidate));
+
+  if (_hasCandidate) {
+    event->Set(StringTable::Get(kStringCandidate),
+               RTCIceCandidate::Create(_candidate));
+  } else {
+    event->Set(StringTable::Get(kStringCandidate), Nan::Null());
+  }
+
+  target->Dispatch(kStringOnIceCandidate, event);
+}
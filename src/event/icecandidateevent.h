@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_ICECANDIDATEEVENT_H_
+#define EVENT_ICECANDIDATEEVENT_H_
+
+#include <webrtc/api/jsep.h>
+#include "candidateinfo.h"
+#include "eventpool.h"
+#include "peerconnectionevent.h"
+
+class IceCandidateEvent :
+    public PooledEvent<IceCandidateEvent, PeerConnectionEvent> {
+ public:
+  explicit IceCandidateEvent(PeerConnectionObserver *observer);
+
+  void Handle();
+
+  // Leaving the candidate unset signals the end of candidates.
+  void SetCandidate(const webrtc::IceCandidateInterface *candidate);
+
+ private:
+  bool _hasCandidate;
+  CandidateInfo _candidate;
+};
+
+#endif  // EVENT_ICECANDIDATEEVENT_H_
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <nan.h>
+#include "common.h"
+#include "icecandidatesevent.h"
+#include "rtcicecandidate.h"
+#include "rtcpeerconnection.h"
+#include "stringtable.h"
+
+IceCandidatesEvent::IceCandidatesEvent(PeerConnectionObserver *observer)
+    : PooledEvent(observer),
+      _endOfCandidates(false) {
+}
+
+void IceCandidatesEvent::AddCandidate(
+    const webrtc::IceCandidateInterface *candidate) {
+  CandidateInfo entry;
+
+  if (!DescribeCandidate(*candidate, &entry)) {
+    return;
+  }
+
+  _candidates.push_back(entry);
+}
+
+void IceCandidatesEvent::SetEndOfCandidates() {
+  _endOfCandidates = true;
+}
+
+void IceCandidatesEvent::Handle() {
+  RTCPeerConnection *target = GetTarget();
+
+  if (!target) {
+    return;
+  }
+
+  Nan::HandleScope scope;
+  Local<Array> candidates = Nan::New<Array>(_candidates.size());
+
+  for (uint32_t i = 0; i < _candidates.size(); i++) {
+    Nan::Set(candidates, i, RTCIceCandidate::Create(_candidates[i]));
+  }
+
+  Local<Object> event = Nan::New<Object>();
+  event->Set(StringTable::Get(kStringType),
+             StringTable::Get(kStringIceCandidates));
+  event->Set(StringTable::Get(kStringCandidates), candidates);
+  event->Set(StringTable::Get(kStringEndOfCandidates),
+             Nan::New(_endOfCandidates));
+
+  target->Dispatch(kStringOnIceCandidates, event);
+}
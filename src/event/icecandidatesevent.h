@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_ICECANDIDATESEVENT_H_
+#define EVENT_ICECANDIDATESEVENT_H_
+
+#include <webrtc/api/jsep.h>
+#include <vector>
+#include "candidateinfo.h"
+#include "eventpool.h"
+#include "peerconnectionevent.h"
+
+// A batch of ICE candidates, used when the connection has been created with
+// a non-zero 'iceCandidateBatchWindow'. The observer fills it on the
+// signaling thread and hands it to the EventQueue once the window elapses or
+// gathering completes.
+class IceCandidatesEvent :
+    public PooledEvent<IceCandidatesEvent, PeerConnectionEvent> {
+ public:
+  explicit IceCandidatesEvent(PeerConnectionObserver *observer);
+
+  void Handle();
+
+  void AddCandidate(const webrtc::IceCandidateInterface *candidate);
+  void SetEndOfCandidates();
+
+ private:
+  std::vector<CandidateInfo> _candidates;
+  bool _endOfCandidates;
+};
+
+#endif  // EVENT_ICECANDIDATESEVENT_H_
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_MPSCQUEUE_H_
+#define EVENT_MPSCQUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+
+template <class T> class MpscQueue;
+
+// Link embedded in every object that can be pushed into a MpscQueue.
+class MpscNode {
+ public:
+  MpscNode() : _next(NULL) {}
+
+ private:
+  template <class T> friend class MpscQueue;
+
+  std::atomic<MpscNode*> _next;
+};
+
+// Intrusive multi-producer single-consumer queue (Vyukov). Push() is
+// wait-free and may be called from any thread. Pop() must only be called
+// from the consumer thread, and may return NULL while a concurrent Push()
+// is still linking its node: the producer is expected to wake the consumer
+// again once Push() returns.
+template <class T>
+class MpscQueue {
+ public:
+  MpscQueue() : _head(&_stub), _tail(&_stub) {}
+
+  void Push(T *item) {
+    Link(item);
+  }
+
+  T *Pop() {
+    MpscNode *tail = _tail;
+    MpscNode *next = tail->_next.load(std::memory_order_acquire);
+
+    if (tail == &_stub) {
+      if (!next) {
+        return NULL;
+      }
+
+      _tail = next;
+      tail = next;
+      next = next->_next.load(std::memory_order_acquire);
+    }
+
+    if (next) {
+      _tail = next;
+      return static_cast<T*>(tail);
+    }
+
+    if (tail != _head.load(std::memory_order_acquire)) {
+      return NULL;
+    }
+
+    Link(&_stub);
+    next = tail->_next.load(std::memory_order_acquire);
+
+    if (next) {
+      _tail = next;
+      return static_cast<T*>(tail);
+    }
+
+    return NULL;
+  }
+
+ private:
+  void Link(MpscNode *node) {
+    node->_next.store(NULL, std::memory_order_relaxed);
+    MpscNode *prev = _head.exchange(node, std::memory_order_acq_rel);
+    prev->_next.store(node, std::memory_order_release);
+  }
+
+  std::atomic<MpscNode*> _head;
+  MpscNode *_tail;
+  MpscNode _stub;
+};
+
+#endif  // EVENT_MPSCQUEUE_H_
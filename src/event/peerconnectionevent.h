@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_PEERCONNECTIONEVENT_H_
+#define EVENT_PEERCONNECTIONEVENT_H_
+
+#include <webrtc/base/scoped_ref_ptr.h>
+#include "event.h"
+
+class PeerConnectionObserver;
+class RTCPeerConnection;
+
+// Base class for events raised by a PeerConnectionObserver. It keeps the
+// observer alive until the event has been handled on the main thread, where
+// the target RTCPeerConnection may already have been garbage collected.
+class PeerConnectionEvent : public Event {
+ public:
+  explicit PeerConnectionEvent(PeerConnectionObserver *observer);
+  ~PeerConnectionEvent();
+
+ protected:
+  // Returns NULL once the RTCPeerConnection wrapper is gone.
+  RTCPeerConnection *GetTarget() const;
+
+ private:
+  rtc::scoped_refptr<PeerConnectionObserver> _observer;
+};
+
+#endif  // EVENT_PEERCONNECTIONEVENT_H_
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common.h"
+#include "rtcsessiondescription.h"
+#include "sessiondescriptionparsedevent.h"
+
+SessionDescriptionParsedEvent::SessionDescriptionParsedEvent(
+    Local<Promise::Resolver> resolver, Local<String> sdp)
+    : _resolver(resolver),
+      _sdp(sdp),
+      _sessionDescription(NULL) {
+}
+
+SessionDescriptionParsedEvent::~SessionDescriptionParsedEvent() {
+  delete _sessionDescription;
+}
+
+void SessionDescriptionParsedEvent::Handle() {
+  Nan::HandleScope scope;
+  Local<Promise::Resolver> resolver = Nan::New(_resolver);
+
+  if (_sessionDescription) {
+    // The wrapper takes ownership of the description.
+    resolver->Resolve(RTCSessionDescription::Create(_sessionDescription,
+                                                    Nan::New(_sdp)));
+    _sessionDescription = NULL;
+  } else {
+    std::string error(ERROR_CALL_PREFIX("RTCSessionDescription", "parse"));
+    error += _error;
+    resolver->Reject(Nan::TypeError(error.c_str()));
+  }
+
+  _resolver.Reset();
+  _sdp.Reset();
+}
+
+void SessionDescriptionParsedEvent::SetError(const std::string &error) {
+  _error = error;
+}
+
+void SessionDescriptionParsedEvent::SetSessionDescription(
+    webrtc::SessionDescriptionInterface *sessionDescription) {
+  _sessionDescription = sessionDescription;
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_SESSIONDESCRIPTIONPARSEDEVENT_H_
+#define EVENT_SESSIONDESCRIPTIONPARSEDEVENT_H_
+
+#include <nan.h>
+#include <webrtc/api/jsep.h>
+#include <string>
+#include "eventpool.h"
+
+using namespace v8;
+
+// Settles the promise of RTCSessionDescription.parse().
+class SessionDescriptionParsedEvent :
+    public PooledEvent<SessionDescriptionParsedEvent> {
+ public:
+  SessionDescriptionParsedEvent(Local<Promise::Resolver> resolver,
+                                Local<String> sdp);
+  ~SessionDescriptionParsedEvent();
+
+  void Handle();
+
+  void SetError(const std::string &error);
+  void SetSessionDescription(
+      webrtc::SessionDescriptionInterface *sessionDescription);
+
+ private:
+  Nan::Persistent<Promise::Resolver> _resolver;
+  Nan::Persistent<String> _sdp;
+  std::string _error;
+  webrtc::SessionDescriptionInterface *_sessionDescription;
+};
+
+#endif  // EVENT_SESSIONDESCRIPTIONPARSEDEVENT_H_
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common.h"
+#include "setsessiondescriptionevent.h"
+
+using namespace v8;
+
+static const char kName[] = "name";
+
+SetSessionDescriptionEvent::SetSessionDescriptionEvent(
+    Local<Function> successCallback,
+    Local<Function> failureCallback) :
+    _successCallback(successCallback),
+    _failureCallback(failureCallback),
+    _succeeded(false) {
+}
+
+SetSessionDescriptionEvent::SetSessionDescriptionEvent(
+    Local<Promise::Resolver> resolver) :
+    _resolver(resolver),
+    _succeeded(false) {
+}
+
+void SetSessionDescriptionEvent::Handle() {
+  Nan::HandleScope scope;
+
+  if (!_resolver.IsEmpty()) {
+    Local<Promise::Resolver> resolver = Nan::New(_resolver);
+
+    if (_succeeded) {
+      resolver->Resolve(Nan::Undefined());
+    } else {
+      resolver->Reject(CreateError());
+    }
+
+    _resolver.Reset();
+    return;
+  }
+
+  if (_succeeded) {
+    Local<Function> successCallback = Nan::New(_successCallback);
+    Nan::Call(successCallback, Nan::GetCurrentContext()->Global(), 0, NULL);
+  } else {
+    Local<Function> failureCallback = Nan::New(_failureCallback);
+
+    const int argc = 1;
+    Local<Value> argv[1] = { CreateError() };
+
+    Nan::Call(failureCallback, Nan::GetCurrentContext()->Global(), argc, argv);
+  }
+
+  _successCallback.Reset();
+  _failureCallback.Reset();
+}
+
+void SetSessionDescriptionEvent::SetSucceeded(bool succeeded) {
+  _succeeded = succeeded;
+}
+
+void SetSessionDescriptionEvent::SetErrorMessage(
+    const std::string &errorMessage) {
+  _errorMessage = errorMessage;
+}
+
+void SetSessionDescriptionEvent::SetErrorName(const std::string &errorName) {
+  _errorName = errorName;
+}
+
+Local<Value> SetSessionDescriptionEvent::CreateError() {
+  Local<Value> error = Nan::Error(_errorMessage.c_str());
+
+  if (!_errorName.empty()) {
+    Nan::Set(error.As<Object>(), LOCAL_STRING(kName),
+             LOCAL_STRING(_errorName));
+  }
+
+  return error;
+}
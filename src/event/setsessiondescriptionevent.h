@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_SETSESSIONDESCRIPTIONEVENT_H_
+#define EVENT_SETSESSIONDESCRIPTIONEVENT_H_
+
+#include <nan.h>
+#include <string>
+#include "eventpool.h"
+
+using namespace v8;
+
+class SetSessionDescriptionEvent :
+    public PooledEvent<SetSessionDescriptionEvent> {
+ public:
+  explicit SetSessionDescriptionEvent(Local<Promise::Resolver> resolver);
+  SetSessionDescriptionEvent(Local<Function> successCallback,
+                             Local<Function> failureCallback);
+
+  void Handle();
+  void SetSucceeded(bool succeeded);
+  void SetErrorMessage(const std::string& errorMessage);
+  // The name given to the Error, "Error" when not set.
+  void SetErrorName(const std::string& errorName);
+
+ private:
+  Local<Value> CreateError();
+
+  Nan::Persistent<Promise::Resolver> _resolver;
+  Nan::Persistent<Function> _successCallback;
+  Nan::Persistent<Function> _failureCallback;
+  bool _succeeded;
+  std::string _errorMessage;
+  std::string _errorName;
+};
+
+#endif  // EVENT_SETSESSIONDESCRIPTIONEVENT_H_
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <nan.h>
+#include "common.h"
+#include "rtcpeerconnection.h"
+#include "statechangeevent.h"
+#include "stringtable.h"
+
+StateChangeEvent::StateChangeEvent(PeerConnectionObserver *observer,
+                                   Kind kind, int state)
+    : PooledEvent(observer),
+      _kind(kind),
+      _state(state) {
+}
+
+void StateChangeEvent::Handle() {
+  RTCPeerConnection *target = GetTarget();
+
+  if (!target) {
+    return;
+  }
+
+  Nan::HandleScope scope;
+  Local<Object> event = Nan::New<Object>();
+
+  switch (_kind) {
+    case kSignalingState:
+      target->SetSignalingState(
+          static_cast<webrtc::PeerConnectionInterface::SignalingState>(
+              _state));
+      event->Set(StringTable::Get(kStringType),
+                 StringTable::Get(kStringSignalingStateChange));
+      target->Dispatch(kStringOnSignalingStateChange, event);
+      break;
+
+    case kIceGatheringState:
+      target->SetIceGatheringState(
+          static_cast<webrtc::PeerConnectionInterface::IceGatheringState>(
+              _state));
+      event->Set(StringTable::Get(kStringType),
+                 StringTable::Get(kStringIceGatheringStateChange));
+      target->Dispatch(kStringOnIceGatheringStateChange, event);
+      break;
+
+    case kIceConnectionState:
+      target->SetIceConnectionState(
+          static_cast<webrtc::PeerConnectionInterface::IceConnectionState>(
+              _state));
+      event->Set(StringTable::Get(kStringType),
+                 StringTable::Get(kStringIceConnectionStateChange));
+      target->Dispatch(kStringOnIceConnectionStateChange, event);
+      break;
+  }
+}
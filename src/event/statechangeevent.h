@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_STATECHANGEEVENT_H_
+#define EVENT_STATECHANGEEVENT_H_
+
+#include <webrtc/api/peerconnectioninterface.h>
+#include "eventpool.h"
+#include "peerconnectionevent.h"
+
+// Carries a new signaling, ICE gathering or ICE connection state. The state
+// is applied to the RTCPeerConnection wrapper right before the matching
+// on*statechange handler runs, so the state getters never have to call into
+// the signaling thread.
+class StateChangeEvent :
+    public PooledEvent<StateChangeEvent, PeerConnectionEvent> {
+ public:
+  enum Kind {
+    kSignalingState,
+    kIceGatheringState,
+    kIceConnectionState,
+  };
+
+  StateChangeEvent(PeerConnectionObserver *observer, Kind kind, int state);
+
+  void Handle();
+
+ private:
+  Kind _kind;
+  int _state;
+};
+
+#endif  // EVENT_STATECHANGEEVENT_H_
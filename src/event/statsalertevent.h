@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_STATSALERTEVENT_H_
+#define EVENT_STATSALERTEVENT_H_
+
+#include "eventpool.h"
+#include "peerconnectionevent.h"
+#include "stats.h"
+
+class StatsAlertEvent :
+    public PooledEvent<StatsAlertEvent, PeerConnectionEvent> {
+ public:
+  StatsAlertEvent(PeerConnectionObserver *observer, StatsField field,
+                  double value, double threshold);
+
+  void Handle();
+
+ private:
+  StatsField _field;
+  double _value;
+  double _threshold;
+};
+
+#endif  // EVENT_STATSALERTEVENT_H_
@@ -24,16 +24,38 @@
 
 #include <webrtc/base/ssladapter.h>
 #include <iostream>
+#include <sstream>
+#include "addondata.h"
 #include "globals.h"
+#include "logger.h"
 
-EventQueue *Globals::_eventQueue = NULL;
-rtc::Thread *Globals::_signalingThread = NULL;
-rtc::Thread *Globals::_workerThread = NULL;
-rtc::RTCCertificateGenerator *Globals::_certificateGenerator = NULL;
+GlobalOptions::GlobalOptions()
+    : threadGroupCount(1),
+      placementPolicy(kPlacementRoundRobin) {
+}
+
+static uv_once_t sInitOnce = UV_ONCE_INIT;
+
+rtc::CriticalSection Globals::_lock;
+bool Globals::_initialized = false;
+CertificatePool *Globals::_certificatePool = NULL;
+GlobalOptions Globals::_options;
+bool Globals::_started = false;
+std::vector<ThreadGroup*> Globals::_threadGroups;
+size_t Globals::_nextThreadGroup = 0;
+
+static std::string ThreadName(const std::string &name, size_t id) {
+  std::stringstream stream;
+  stream << name << "_" << id;
+  return stream.str();
+}
 
 bool Globals::Init() {
-  _eventQueue = new EventQueue();
+  uv_once(&sInitOnce, Globals::InitOnce);
+  return _initialized;
+}
 
+void Globals::InitOnce() {
 #if WEBRTC_WIN
   rtc::EnsureWinsockInit();
 #endif
@@ -41,53 +63,142 @@ bool Globals::Init() {
   rtc::InitializeSSL();
   rtc::InitRandom(rtc::Time());
 
-  _signalingThread = new rtc::Thread();
-  _workerThread = new rtc::Thread();
+  // Registered once, from the main thread which loads the module first.
+  node::AtExit(Globals::Cleanup);
 
-  _signalingThread->SetName("signaling_thread", NULL);
-  _workerThread->SetName("worker_thread", NULL);
+  _initialized = true;
+}
 
-  if (!_signalingThread->Start() ||
-      !_workerThread->Start()) {
-    return false;
+bool Globals::Start() {
+  rtc::CritScope lock(&_lock);
+
+  if (_started) {
+    return true;
   }
 
-  _certificateGenerator =
-      new rtc::RTCCertificateGenerator(_signalingThread, _workerThread);
+  for (size_t id = 0; id < _options.threadGroupCount; ++id) {
+    ThreadOptions threadOptions = _options.threads;
+
+    // Keep the plain thread names when there is a single group.
+    if (_options.threadGroupCount > 1) {
+      threadOptions.signalingThreadName =
+          ThreadName(threadOptions.signalingThreadName, id);
+      threadOptions.workerThreadName =
+          ThreadName(threadOptions.workerThreadName, id);
+      threadOptions.networkThreadName =
+          ThreadName(threadOptions.networkThreadName, id);
+    }
+
+    ThreadGroup *threadGroup = new ThreadGroup(id, threadOptions);
+    _threadGroups.push_back(threadGroup);
+
+    if (!threadGroup->Start()) {
+      for (size_t i = 0; i < _threadGroups.size(); ++i) {
+        delete _threadGroups[i];
+      }
+
+      _threadGroups.clear();
+      return false;
+    }
+
+    if (_options.stats.period) {
+      threadGroup->StartStatsSampler(_options.stats);
+    }
+  }
 
+  if (_options.certificatePool.ecdsa || _options.certificatePool.rsa) {
+    _certificatePool = new CertificatePool(_options.certificatePool);
+
+    // The connections generate their own certificates without a pool.
+    if (!_certificatePool->Start()) {
+      delete _certificatePool;
+      _certificatePool = NULL;
+    }
+  }
+
+  _started = true;
   return true;
 }
 
+bool Globals::IsStarted() {
+  rtc::CritScope lock(&_lock);
+  return _started;
+}
+
+bool Globals::SetOptions(const GlobalOptions& options) {
+  rtc::CritScope lock(&_lock);
+
+  if (_started) {
+    return false;
+  }
+
+  _options = options;
+  return true;
+}
+
+const GlobalOptions& Globals::GetOptions() {
+  return _options;
+}
+
 void Globals::Cleanup(void* args) {
-  delete _certificateGenerator;
+  // The main environment goes first, its connections must be released while
+  // the WebRTC threads are still running.
+  AddonData::Destroy();
 
-  _signalingThread->Stop();
-  _workerThread->Stop();
+  rtc::CritScope lock(&_lock);
 
-  delete _signalingThread;
-  delete _workerThread;
+  delete _certificatePool;
+  _certificatePool = NULL;
 
-  _signalingThread = NULL;
-  _workerThread = NULL;
+  for (size_t i = 0; i < _threadGroups.size(); ++i) {
+    delete _threadGroups[i];
+  }
 
-  rtc::CleanupSSL();
+  _threadGroups.clear();
+  _started = false;
 
-  delete _eventQueue;
-  _eventQueue = NULL;
+  Logger::Stop();
+
+  rtc::CleanupSSL();
 }
 
-EventQueue *Globals::GetEventQueue() {
-  return _eventQueue;
+CertificatePool *Globals::GetCertificatePool() {
+  return _certificatePool;
 }
 
-rtc::RTCCertificateGenerator *Globals::GetCertificateGenerator() {
-  return _certificateGenerator;
+size_t Globals::GetThreadGroupCount() {
+  return _threadGroups.size();
 }
 
-rtc::Thread *Globals::GetSignalingThread() {
-  return _signalingThread;
+ThreadGroup *Globals::GetThreadGroup(size_t id) {
+  if (id >= _threadGroups.size()) {
+    return NULL;
+  }
+
+  return _threadGroups[id];
 }
 
-rtc::Thread *Globals::GetWorkerThread() {
-  return _workerThread;
+ThreadGroup *Globals::SelectThreadGroup() {
+  rtc::CritScope lock(&_lock);
+
+  if (_threadGroups.empty()) {
+    return NULL;
+  }
+
+  if (_options.placementPolicy == kPlacementLeastConnections) {
+    ThreadGroup *selected = _threadGroups[0];
+
+    for (size_t i = 1; i < _threadGroups.size(); ++i) {
+      if (_threadGroups[i]->GetConnectionCount() <
+          selected->GetConnectionCount()) {
+        selected = _threadGroups[i];
+      }
+    }
+
+    return selected;
+  }
+
+  ThreadGroup *selected = _threadGroups[_nextThreadGroup];
+  _nextThreadGroup = (_nextThreadGroup + 1) % _threadGroups.size();
+  return selected;
 }
@@ -17,26 +17,67 @@
 #ifndef GLOBALS_H_
 #define GLOBALS_H_
 
-#include "event/eventqueue.h"
-#include <webrtc/api/peerconnectioninterface.h>
-#include <webrtc/base/thread.h>
+#include <webrtc/base/criticalsection.h>
+#include <vector>
+#include "certificatepool.h"
+#include "statssampler.h"
+#include "threadgroup.h"
 
+enum PlacementPolicy {
+  kPlacementRoundRobin,
+  kPlacementLeastConnections,
+};
+
+struct GlobalOptions {
+  GlobalOptions();
+
+  ThreadOptions threads;
+  size_t threadGroupCount;
+  PlacementPolicy placementPolicy;
+  StatsSamplerOptions stats;
+  CertificatePoolOptions certificatePool;
+};
+
+// Process-wide state, shared by the main thread and every worker which
+// loads the module. What belongs to a single JavaScript environment lives in
+// AddonData instead.
 class Globals {
  public:
+  // Only the first call initializes, the others return its result.
   static bool Init();
   static void Cleanup(void* args);
 
-  static EventQueue *GetEventQueue();
-  static rtc::RTCCertificateGenerator *GetCertificateGenerator();
-  static rtc::Thread *GetSignalingThread();
-  static rtc::Thread *GetWorkerThread();
+  // Starts every thread group using the current GlobalOptions. Called before
+  // the first connection or certificate is created; later calls are no-ops.
+  static bool Start();
+  static bool IsStarted();
+
+  // Fails once the threads have been started.
+  static bool SetOptions(const GlobalOptions& options);
+  static const GlobalOptions& GetOptions();
+
+  // NULL unless a pool size was configured.
+  static CertificatePool *GetCertificatePool();
+
+  static size_t GetThreadGroupCount();
+  static ThreadGroup *GetThreadGroup(size_t id);
+
+  // Picks the group a new connection should live on, according to the
+  // placement policy.
+  static ThreadGroup *SelectThreadGroup();
+
+  static const size_t kMaxThreadGroups = 64;
 
  private:
-  static EventQueue *_eventQueue;
-  static rtc::Thread *_signalingThread;
-  static rtc::Thread *_workerThread;
-  static rtc::RTCCertificateGenerator *_certificateGenerator;
-  static webrtc::PeerConnectionFactoryInterface *_peerConnectionFactory;
+  static void InitOnce();
+
+  static rtc::CriticalSection _lock;
+  static bool _initialized;
+  static CertificatePool *_certificatePool;
+  static GlobalOptions _options;
+  static bool _started;
+  static std::vector<ThreadGroup*> _threadGroups;
+  static size_t _nextThreadGroup;
 };
 
 #endif  // GLOBALS_H_
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <webrtc/base/logging.h>
+#include <cstdarg>
+#include <cstdio>
+#include "logger.h"
+
+// Interval at which the writer thread polls the ring, so producers never
+// have to signal it.
+static const uint64_t kWriterIntervalNs = 20 * 1000 * 1000;
+
+static const char *const kCategoryNames[kLogCategoryCount] = {
+  "peerconnection",
+  "datachannel",
+};
+
+static const char *const kLevelNames[kLogNone + 1] = {
+  "verbose", "info", "warning", "error", "none",
+};
+
+static const rtc::LoggingSeverity kSeverities[kLogNone] = {
+  rtc::LS_VERBOSE, rtc::LS_INFO, rtc::LS_WARNING, rtc::LS_ERROR,
+};
+
+std::atomic<int> Logger::_verbosity[kLogCategoryCount];
+
+std::atomic<int> Logger::_sink(kLogSinkStdout);
+std::atomic<size_t> Logger::_enqueuePosition(0);
+std::atomic<uint64_t> Logger::_dropped(0);
+size_t Logger::_dequeuePosition = 0;
+Logger::Slot Logger::_slots[Logger::kCapacity];
+
+uv_once_t Logger::_startOnce = UV_ONCE_INIT;
+std::atomic<bool> Logger::_started(false);
+uv_thread_t Logger::_thread;
+uv_mutex_t Logger::_mutex;
+uv_cond_t Logger::_condition;
+bool Logger::_running = false;
+
+void Logger::Start() {
+  for (size_t i = 0; i < kCapacity; ++i) {
+    _slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  uv_mutex_init(&_mutex);
+  uv_cond_init(&_condition);
+
+  _running = true;
+  uv_thread_create(&_thread, Logger::Run, NULL);
+  _started.store(true);
+}
+
+void Logger::Stop() {
+  if (!_started.load()) {
+    return;
+  }
+
+  uv_mutex_lock(&_mutex);
+
+  if (!_running) {
+    uv_mutex_unlock(&_mutex);
+    return;
+  }
+
+  _running = false;
+  uv_cond_signal(&_condition);
+  uv_mutex_unlock(&_mutex);
+
+  uv_thread_join(&_thread);
+}
+
+void Logger::Run(void *args) {
+  uv_mutex_lock(&_mutex);
+
+  while (_running) {
+    uv_mutex_unlock(&_mutex);
+
+    if (!Drain()) {
+      uv_mutex_lock(&_mutex);
+
+      if (_running) {
+        uv_cond_timedwait(&_condition, &_mutex, kWriterIntervalNs);
+      }
+
+      continue;
+    }
+
+    uv_mutex_lock(&_mutex);
+  }
+
+  uv_mutex_unlock(&_mutex);
+  Drain();
+}
+
+bool Logger::Drain() {
+  bool drained = false;
+
+  for (;;) {
+    Slot &slot = _slots[_dequeuePosition & (kCapacity - 1)];
+    size_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+    if (sequence != _dequeuePosition + 1) {
+      break;
+    }
+
+    Output(slot);
+    slot.sequence.store(_dequeuePosition + kCapacity,
+                        std::memory_order_release);
+    ++_dequeuePosition;
+    drained = true;
+  }
+
+  if (drained) {
+    fflush(stdout);
+    fflush(stderr);
+  }
+
+  return drained;
+}
+
+void Logger::Output(const Slot &slot) {
+  switch (_sink.load(std::memory_order_relaxed)) {
+    case kLogSinkWebRTC:
+      rtc::LogMessage(__FILE__, __LINE__, kSeverities[slot.level]).stream()
+          << "[webrtc:" << kCategoryNames[slot.category] << "] "
+          << slot.message;
+      break;
+
+    case kLogSinkStderr:
+      fprintf(stderr, "[webrtc:%s] %s\n", kCategoryNames[slot.category],
+              slot.message);
+      break;
+
+    default:
+      fprintf(stdout, "[webrtc:%s] %s\n", kCategoryNames[slot.category],
+              slot.message);
+      break;
+  }
+}
+
+void Logger::Write(LogCategory category, LogLevel level,
+                   const char *format, ...) {
+  size_t position = _enqueuePosition.load(std::memory_order_relaxed);
+  Slot *slot;
+
+  for (;;) {
+    slot = &_slots[position & (kCapacity - 1)];
+    size_t sequence = slot->sequence.load(std::memory_order_acquire);
+    intptr_t difference =
+        static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+    if (!difference) {
+      if (_enqueuePosition.compare_exchange_weak(
+              position, position + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (difference < 0) {
+      _dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    } else {
+      position = _enqueuePosition.load(std::memory_order_relaxed);
+    }
+  }
+
+  va_list args;
+  va_start(args, format);
+  vsnprintf(slot->message, kMessageSize, format, args);
+  va_end(args);
+
+  slot->category = category;
+  slot->level = level;
+  slot->sequence.store(position + 1, std::memory_order_release);
+}
+
+void Logger::SetLevel(LogCategory category, LogLevel level) {
+  if (level != kLogNone) {
+    uv_once(&_startOnce, Logger::Start);
+  }
+
+  _verbosity[category].store(kLogNone - level, std::memory_order_relaxed);
+}
+
+LogLevel Logger::GetLevel(LogCategory category) {
+  return static_cast<LogLevel>(
+      kLogNone - _verbosity[category].load(std::memory_order_relaxed));
+}
+
+void Logger::SetSink(LogSink sink) {
+  _sink.store(sink, std::memory_order_relaxed);
+}
+
+uint64_t Logger::GetDroppedCount() {
+  return _dropped.load(std::memory_order_relaxed);
+}
+
+const char *Logger::GetCategoryName(LogCategory category) {
+  return kCategoryNames[category];
+}
+
+const char *Logger::GetLevelName(LogLevel level) {
+  return kLevelNames[level];
+}
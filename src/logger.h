@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LOGGER_H_
+#define LOGGER_H_
+
+#include <uv.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+enum LogCategory {
+  kLogPeerConnection,
+  kLogDataChannel,
+  kLogCategoryCount,
+};
+
+enum LogLevel {
+  kLogVerbose,
+  kLogInfo,
+  kLogWarning,
+  kLogError,
+  kLogNone,
+};
+
+enum LogSink {
+  kLogSinkStdout,
+  kLogSinkStderr,
+  kLogSinkWebRTC,
+};
+
+// Asynchronous logger for the WebRTC threads. Producers format their message
+// straight into a slot of a fixed-size lock-free ring buffer, and a background
+// thread writes the slots out to the selected sink. Messages are dropped, and
+// counted, when the ring is full. Every category is disabled by default, in
+// which case LOGGER() costs a single relaxed atomic load.
+class Logger {
+ public:
+  static void Stop();
+
+  static inline bool IsEnabled(LogCategory category, LogLevel level) {
+    return kLogNone - level <=
+        _verbosity[category].load(std::memory_order_relaxed);
+  }
+
+  static void Write(LogCategory category, LogLevel level,
+                    const char *format, ...);
+
+  static void SetLevel(LogCategory category, LogLevel level);
+  static LogLevel GetLevel(LogCategory category);
+  static void SetSink(LogSink sink);
+  static uint64_t GetDroppedCount();
+
+  static const char *GetCategoryName(LogCategory category);
+  static const char *GetLevelName(LogLevel level);
+
+ private:
+  static const size_t kCapacity = 1024;
+  static const size_t kMessageSize = 240;
+
+  struct Slot {
+    std::atomic<size_t> sequence;
+    LogCategory category;
+    LogLevel level;
+    char message[kMessageSize];
+  };
+
+  static void Start();
+  static void Run(void *args);
+  static bool Drain();
+  static void Output(const Slot &slot);
+
+  // Number of levels enabled for each category, counted from kLogError, so
+  // that the zero-initialized state disables everything.
+  static std::atomic<int> _verbosity[kLogCategoryCount];
+  static std::atomic<int> _sink;
+  static std::atomic<size_t> _enqueuePosition;
+  static std::atomic<uint64_t> _dropped;
+  static size_t _dequeuePosition;
+  static Slot _slots[kCapacity];
+
+  static uv_once_t _startOnce;
+  static std::atomic<bool> _started;
+  static uv_thread_t _thread;
+  static uv_mutex_t _mutex;
+  static uv_cond_t _condition;
+  static bool _running;
+};
+
+#define LOGGER(CATEGORY, LEVEL, ...) \
+  do { \
+    if (Logger::IsEnabled(CATEGORY, LEVEL)) { \
+      Logger::Write(CATEGORY, LEVEL, __VA_ARGS__); \
+    } \
+  } while (0)
+
+#endif  // LOGGER_H_
@@ -15,24 +15,439 @@
  */
 
 #include <nan.h>
+#include <cstring>
 #include <iostream>
+#include "addondata.h"
+#include "common.h"
+#include "event/eventpool.h"
 #include "globals.h"
+#include "logger.h"
 #include "rtccertificate.h"
+#include "rtcdatachannel.h"
 #include "rtcicecandidate.h"
 #include "rtcpeerconnection.h"
 #include "rtcsessiondescription.h"
+#include "stringtable.h"
+
+static const char kConfigure[] = "configure";
+static const char kGetCertificatePoolStats[] = "getCertificatePoolStats";
+static const char kGetEventPoolStats[] = "getEventPoolStats";
+static const char kGetThreadGroups[] = "getThreadGroups";
+static const char kGetThreads[] = "getThreads";
+static const char kSetLogLevel[] = "setLogLevel";
+static const char kSetLogSink[] = "setLogSink";
+static const char kGetLogStats[] = "getLogStats";
+
+static const char kStdout[] = "stdout";
+static const char kStderr[] = "stderr";
+static const char kWebRTC[] = "webrtc";
+static const char kLevels[] = "levels";
+static const char kDropped[] = "dropped";
+
+static const char kThreads[] = "threads";
+static const char kSignaling[] = "signaling";
+static const char kWorker[] = "worker";
+static const char kNetwork[] = "network";
+static const char kName[] = "name";
+static const char kRole[] = "role";
+static const char kGroup[] = "group";
+static const char kThreadGroups[] = "threadGroups";
+static const char kPlacement[] = "placement";
+static const char kRoundRobin[] = "round-robin";
+static const char kLeastConnections[] = "least-connections";
+static const char kId[] = "id";
+static const char kConnections[] = "connections";
+static const char kTotalConnections[] = "totalConnections";
+static const char kStats[] = "stats";
+static const char kPeriod[] = "period";
+static const char kHistory[] = "history";
+static const char kFields[] = "fields";
+static const char kCertificatePool[] = "certificatePool";
+static const char kECDSA[] = "ecdsa";
+static const char kRSA[] = "rsa";
+static const char kHits[] = "hits";
+static const char kMisses[] = "misses";
+
+static const char kHeapAllocations[] = "heapAllocations";
+static const char kPooledAllocations[] = "pooledAllocations";
+static const char kReleases[] = "releases";
+static const char kRemoteReleases[] = "remoteReleases";
+
+NAN_METHOD(GetEventPoolStats) {
+  EventPoolStats stats = EventPool::GetStats();
+  Local<Object> result = Nan::New<Object>();
+
+  result->Set(LOCAL_STRING(kHeapAllocations),
+              Nan::New(static_cast<double>(stats.heapAllocations)));
+  result->Set(LOCAL_STRING(kPooledAllocations),
+              Nan::New(static_cast<double>(stats.pooledAllocations)));
+  result->Set(LOCAL_STRING(kReleases),
+              Nan::New(static_cast<double>(stats.releases)));
+  result->Set(LOCAL_STRING(kRemoteReleases),
+              Nan::New(static_cast<double>(stats.remoteReleases)));
+
+  info.GetReturnValue().Set(result);
+}
+
+NAN_METHOD(GetCertificatePoolStats) {
+  CertificatePoolStats stats = { 0, 0, 0, 0 };
+  CertificatePool *certificatePool = Globals::GetCertificatePool();
+
+  if (certificatePool) {
+    stats = certificatePool->GetStats();
+  }
+
+  Local<Object> result = Nan::New<Object>();
+
+  result->Set(LOCAL_STRING(kHits),
+              Nan::New(static_cast<double>(stats.hits)));
+  result->Set(LOCAL_STRING(kMisses),
+              Nan::New(static_cast<double>(stats.misses)));
+  result->Set(LOCAL_STRING(kECDSA), Nan::New(stats.ecdsa));
+  result->Set(LOCAL_STRING(kRSA), Nan::New(stats.rsa));
+
+  info.GetReturnValue().Set(result);
+}
+
+static const char eStarted[] =
+    "The WebRTC threads are already running, configure() must be called "
+    "before the first RTCPeerConnection is created.";
+static const char eThreadGroups[] =
+    "The 'threadGroups' property is out of range.";
+static const char eFields[] =
+    "The 'fields' property is not an array of RTCPeerConnection.statsSchema "
+    "names, or is empty.";
+
+static const uint32_t kMaxStatsPeriod = 3600000;
+static const uint32_t kMaxStatsHistory = 86400;
+static const uint32_t kMaxCertificatePoolSize = 1024;
+
+NAN_METHOD(Configure) {
+  METHOD_HEADER("webrtc", "configure");
+
+  ASSERT_SINGLE_ARGUMENT;
+  ASSERT_OBJECT_ARGUMENT(0, options);
+
+  GlobalOptions globalOptions = Globals::GetOptions();
+  ThreadOptions &threadOptions = globalOptions.threads;
+
+  if (HAS_OWN_PROPERTY(options, kThreads)) {
+    DECLARE_OBJECT_PROPERTY(options, kThreads, threadsVal);
+
+    if (!threadsVal->IsObject()) {
+      errorStream << ERROR_PROPERTY_NOT_OBJECT(kThreads);
+      return Nan::ThrowTypeError(errorStream.str().c_str());
+    }
+
+    Local<Object> threads = threadsVal->ToObject();
+
+    if (HAS_OWN_PROPERTY(threads, kSignaling)) {
+      DECLARE_OBJECT_PROPERTY(threads, kSignaling, signalingVal);
+      ASSERT_PROPERTY_STRING(kSignaling, signalingVal, signaling);
+      threadOptions.signalingThreadName = *signaling;
+    }
+
+    if (HAS_OWN_PROPERTY(threads, kWorker)) {
+      DECLARE_OBJECT_PROPERTY(threads, kWorker, workerVal);
+      ASSERT_PROPERTY_STRING(kWorker, workerVal, worker);
+      threadOptions.workerThreadName = *worker;
+    }
+
+    // A null or false network thread shares the worker thread.
+    if (HAS_OWN_PROPERTY(threads, kNetwork)) {
+      DECLARE_OBJECT_PROPERTY(threads, kNetwork, networkVal);
+
+      if (IS_STRICTLY_NULL(networkVal) || networkVal->IsFalse()) {
+        threadOptions.dedicatedNetworkThread = false;
+      } else {
+        ASSERT_PROPERTY_STRING(kNetwork, networkVal, network);
+        threadOptions.dedicatedNetworkThread = true;
+        threadOptions.networkThreadName = *network;
+      }
+    }
+  }
+
+  if (HAS_OWN_PROPERTY(options, kThreadGroups)) {
+    DECLARE_OBJECT_PROPERTY(options, kThreadGroups, threadGroupsVal);
+    ASSERT_PROPERTY_INTEGER(kThreadGroups, threadGroupsVal, threadGroups);
+
+    if (!(threadGroups->Value() >= 1 &&
+          threadGroups->Value() <= Globals::kMaxThreadGroups)) {
+      errorStream << eThreadGroups;
+      return Nan::ThrowRangeError(errorStream.str().c_str());
+    }
+
+    globalOptions.threadGroupCount = threadGroups->Uint32Value();
+  }
+
+  if (HAS_OWN_PROPERTY(options, kPlacement)) {
+    DECLARE_OBJECT_PROPERTY(options, kPlacement, placementVal);
+    ASSERT_PROPERTY_STRING(kPlacement, placementVal, placement);
+
+    if (!strcmp(kRoundRobin, *placement)) {
+      globalOptions.placementPolicy = kPlacementRoundRobin;
+    } else if (!strcmp(kLeastConnections, *placement)) {
+      globalOptions.placementPolicy = kPlacementLeastConnections;
+    } else {
+      errorStream << "The provided value '";
+      errorStream << std::string(*placement);
+      errorStream << "' is not a valid placement policy.";
+      return Nan::ThrowTypeError(errorStream.str().c_str());
+    }
+  }
+
+  if (HAS_OWN_PROPERTY(options, kStats)) {
+    DECLARE_OBJECT_PROPERTY(options, kStats, statsVal);
+
+    if (!statsVal->IsObject()) {
+      errorStream << ERROR_PROPERTY_NOT_OBJECT(kStats);
+      return Nan::ThrowTypeError(errorStream.str().c_str());
+    }
+
+    Local<Object> stats = statsVal->ToObject();
+    StatsSamplerOptions &statsOptions = globalOptions.stats;
+
+    if (HAS_OWN_PROPERTY(stats, kPeriod)) {
+      DECLARE_OBJECT_PROPERTY(stats, kPeriod, periodVal);
+      ASSERT_PROPERTY_INTEGER(kPeriod, periodVal, period);
+
+      if (!(period->Value() >= 0 && period->Value() <= kMaxStatsPeriod)) {
+        errorStream << ERROR_PROPERTY_OUT_OF_RANGE(kPeriod);
+        return Nan::ThrowRangeError(errorStream.str().c_str());
+      }
+
+      statsOptions.period = period->Uint32Value();
+    }
+
+    if (HAS_OWN_PROPERTY(stats, kHistory)) {
+      DECLARE_OBJECT_PROPERTY(stats, kHistory, historyVal);
+      ASSERT_PROPERTY_INTEGER(kHistory, historyVal, history);
+
+      if (!(history->Value() >= 1 && history->Value() <= kMaxStatsHistory)) {
+        errorStream << ERROR_PROPERTY_OUT_OF_RANGE(kHistory);
+        return Nan::ThrowRangeError(errorStream.str().c_str());
+      }
+
+      statsOptions.history = history->Uint32Value();
+    }
+
+    if (HAS_OWN_PROPERTY(stats, kFields)) {
+      DECLARE_OBJECT_PROPERTY(stats, kFields, fieldsVal);
+
+      if (!fieldsVal->IsArray() || !fieldsVal.As<Array>()->Length()) {
+        errorStream << eFields;
+        return Nan::ThrowTypeError(errorStream.str().c_str());
+      }
+
+      Local<Array> fields = fieldsVal.As<Array>();
+      statsOptions.fields.clear();
+
+      for (uint32_t i = 0; i < fields->Length(); ++i) {
+        Local<Value> fieldVal = fields->Get(i);
+        StatsField field;
+
+        if (!fieldVal->IsString() ||
+            !GetStatsField(*String::Utf8Value(fieldVal), &field)) {
+          errorStream << eFields;
+          return Nan::ThrowTypeError(errorStream.str().c_str());
+        }
+
+        statsOptions.fields.push_back(field);
+      }
+    }
+  }
+
+  if (HAS_OWN_PROPERTY(options, kCertificatePool)) {
+    DECLARE_OBJECT_PROPERTY(options, kCertificatePool, certificatePoolVal);
+
+    if (!certificatePoolVal->IsObject()) {
+      errorStream << ERROR_PROPERTY_NOT_OBJECT(kCertificatePool);
+      return Nan::ThrowTypeError(errorStream.str().c_str());
+    }
+
+    Local<Object> certificatePool = certificatePoolVal->ToObject();
+    CertificatePoolOptions &poolOptions = globalOptions.certificatePool;
+
+    if (HAS_OWN_PROPERTY(certificatePool, kECDSA)) {
+      DECLARE_OBJECT_PROPERTY(certificatePool, kECDSA, ecdsaVal);
+      ASSERT_PROPERTY_INTEGER(kECDSA, ecdsaVal, ecdsa);
+
+      if (!(ecdsa->Value() >= 0 &&
+            ecdsa->Value() <= kMaxCertificatePoolSize)) {
+        errorStream << ERROR_PROPERTY_OUT_OF_RANGE(kECDSA);
+        return Nan::ThrowRangeError(errorStream.str().c_str());
+      }
+
+      poolOptions.ecdsa = ecdsa->Uint32Value();
+    }
+
+    if (HAS_OWN_PROPERTY(certificatePool, kRSA)) {
+      DECLARE_OBJECT_PROPERTY(certificatePool, kRSA, rsaVal);
+      ASSERT_PROPERTY_INTEGER(kRSA, rsaVal, rsa);
+
+      if (!(rsa->Value() >= 0 && rsa->Value() <= kMaxCertificatePoolSize)) {
+        errorStream << ERROR_PROPERTY_OUT_OF_RANGE(kRSA);
+        return Nan::ThrowRangeError(errorStream.str().c_str());
+      }
+
+      poolOptions.rsa = rsa->Uint32Value();
+    }
+  }
+
+  if (!Globals::SetOptions(globalOptions)) {
+    errorStream << eStarted;
+    return Nan::ThrowError(errorStream.str().c_str());
+  }
+}
+
+static Local<Array> ThreadsToArray(const std::vector<ThreadInfo> &threads) {
+  Local<Array> result = Nan::New<Array>(threads.size());
+
+  for (uint32_t i = 0; i < threads.size(); ++i) {
+    Local<Object> thread = Nan::New<Object>();
+
+    thread->Set(LOCAL_STRING(kGroup),
+                Nan::New(static_cast<uint32_t>(threads[i].group)));
+    thread->Set(LOCAL_STRING(kRole), LOCAL_STRING(threads[i].role));
+    thread->Set(LOCAL_STRING(kName), LOCAL_STRING(threads[i].name));
+    result->Set(i, thread);
+  }
+
+  return result;
+}
+
+NAN_METHOD(GetThreads) {
+  std::vector<ThreadInfo> threads;
+
+  for (size_t i = 0; i < Globals::GetThreadGroupCount(); ++i) {
+    Globals::GetThreadGroup(i)->GetThreads(&threads);
+  }
+
+  info.GetReturnValue().Set(ThreadsToArray(threads));
+}
+
+NAN_METHOD(GetThreadGroups) {
+  size_t count = Globals::GetThreadGroupCount();
+  Local<Array> result = Nan::New<Array>(count);
+
+  for (uint32_t i = 0; i < count; ++i) {
+    ThreadGroup *threadGroup = Globals::GetThreadGroup(i);
+    std::vector<ThreadInfo> threads;
+    Local<Object> group = Nan::New<Object>();
+
+    threadGroup->GetThreads(&threads);
+
+    group->Set(LOCAL_STRING(kId), Nan::New(i));
+    group->Set(LOCAL_STRING(kConnections),
+               Nan::New(threadGroup->GetConnectionCount()));
+    group->Set(LOCAL_STRING(kTotalConnections), Nan::New(
+        static_cast<double>(threadGroup->GetTotalConnectionCount())));
+    group->Set(LOCAL_STRING(kThreads), ThreadsToArray(threads));
+    result->Set(i, group);
+  }
+
+  info.GetReturnValue().Set(result);
+}
+
+NAN_METHOD(SetLogLevel) {
+  METHOD_HEADER("webrtc", "setLogLevel");
+  ASSERT_ARGUMENTS_COUNT(2);
+
+  ASSERT_PROPERTY_STRING("category", info[0], categoryName);
+  ASSERT_PROPERTY_STRING("level", info[1], levelName);
+
+  int category = 0;
+  while (category < kLogCategoryCount &&
+         strcmp(Logger::GetCategoryName(static_cast<LogCategory>(category)),
+                *categoryName)) {
+    ++category;
+  }
+
+  if (category == kLogCategoryCount) {
+    errorStream << "The provided value '" << std::string(*categoryName);
+    errorStream << "' is not a valid log category.";
+    return Nan::ThrowTypeError(errorStream.str().c_str());
+  }
+
+  int level = 0;
+  while (level <= kLogNone &&
+         strcmp(Logger::GetLevelName(static_cast<LogLevel>(level)),
+                *levelName)) {
+    ++level;
+  }
+
+  if (level > kLogNone) {
+    errorStream << "The provided value '" << std::string(*levelName);
+    errorStream << "' is not a valid log level.";
+    return Nan::ThrowTypeError(errorStream.str().c_str());
+  }
+
+  Logger::SetLevel(static_cast<LogCategory>(category),
+                   static_cast<LogLevel>(level));
+}
+
+NAN_METHOD(SetLogSink) {
+  METHOD_HEADER("webrtc", "setLogSink");
+  ASSERT_SINGLE_ARGUMENT;
+  ASSERT_PROPERTY_STRING("sink", info[0], sink);
+
+  if (!strcmp(kStdout, *sink)) {
+    Logger::SetSink(kLogSinkStdout);
+  } else if (!strcmp(kStderr, *sink)) {
+    Logger::SetSink(kLogSinkStderr);
+  } else if (!strcmp(kWebRTC, *sink)) {
+    Logger::SetSink(kLogSinkWebRTC);
+  } else {
+    errorStream << "The provided value '" << std::string(*sink);
+    errorStream << "' is not a valid log sink.";
+    return Nan::ThrowTypeError(errorStream.str().c_str());
+  }
+}
+
+NAN_METHOD(GetLogStats) {
+  Local<Object> result = Nan::New<Object>();
+  Local<Object> levels = Nan::New<Object>();
+
+  for (int i = 0; i < kLogCategoryCount; ++i) {
+    LogCategory category = static_cast<LogCategory>(i);
+
+    levels->Set(LOCAL_STRING(Logger::GetCategoryName(category)),
+                LOCAL_STRING(Logger::GetLevelName(Logger::GetLevel(category))));
+  }
+
+  result->Set(LOCAL_STRING(kLevels), levels);
+  result->Set(LOCAL_STRING(kDropped),
+              Nan::New(static_cast<double>(Logger::GetDroppedCount())));
+
+  info.GetReturnValue().Set(result);
+}
 
 NAN_MODULE_INIT(Init) {
   if (!Globals::Init()) {
     return;
   }
 
+  AddonData::Create();
+  StringTable::Init();
+
   RTCCertificate::Init(target);
+  RTCDataChannel::Init(target);
   RTCIceCandidate::Init(target);
   RTCPeerConnection::Init(target);
   RTCSessionDescription::Init(target);
 
-  node::AtExit(Globals::Cleanup);
+  Nan::SetMethod(target, kConfigure, Configure);
+  Nan::SetMethod(target, kGetCertificatePoolStats, GetCertificatePoolStats);
+  Nan::SetMethod(target, kGetEventPoolStats, GetEventPoolStats);
+  Nan::SetMethod(target, kGetThreadGroups, GetThreadGroups);
+  Nan::SetMethod(target, kGetThreads, GetThreads);
+  Nan::SetMethod(target, kSetLogLevel, SetLogLevel);
+  Nan::SetMethod(target, kSetLogSink, SetLogSink);
+  Nan::SetMethod(target, kGetLogStats, GetLogStats);
 }
 
+#if defined(NAN_MODULE_WORKER_ENABLED)
+NAN_MODULE_WORKER_ENABLED(webrtc, Init)
+#else
 NODE_MODULE(webrtc, Init)
+#endif
@@ -15,46 +15,92 @@
  */
 
 #include <iostream>
+#include "addondata.h"
 #include "common.h"
 #include "createsessiondescriptionobserver.h"
 #include "event/createsessiondescriptionevent.h"
-#include "globals.h"
+#include "operationschain.h"
 
 using namespace v8;
 
 CreateSessionDescriptionObserver::CreateSessionDescriptionObserver(
-    Persistent<Promise::Resolver> *resolver) {
+    Local<Promise::Resolver> resolver)
+    : _eventQueue(AddonData::Get()->GetEventQueue()) {
   _event = new CreateSessionDescriptionEvent(resolver);
 }
 
 CreateSessionDescriptionObserver::CreateSessionDescriptionObserver(
-    Persistent<Function> *successCallback,
-    Persistent<Function> *failureCallback) {
+    Local<Function> successCallback,
+    Local<Function> failureCallback)
+    : _eventQueue(AddonData::Get()->GetEventQueue()) {
   _event = new CreateSessionDescriptionEvent(successCallback, failureCallback);
 }
 
 CreateSessionDescriptionObserver *CreateSessionDescriptionObserver::
-  Create(Persistent<Function> *successCallback,
-       Persistent<Function> *failureCallback) {
+  Create(Local<Function> successCallback,
+         Local<Function> failureCallback) {
   return new rtc::RefCountedObject<CreateSessionDescriptionObserver>
       (successCallback, failureCallback);
 }
 
 CreateSessionDescriptionObserver *CreateSessionDescriptionObserver::
-  Create(Persistent<Promise::Resolver> *resolver) {
+  Create(Local<Promise::Resolver> resolver) {
   return new rtc::RefCountedObject<CreateSessionDescriptionObserver>
       (resolver);
 }
 
+void CreateSessionDescriptionObserver::SetOperationsChain(
+    OperationsChain *operationsChain) {
+  _operationsChain = operationsChain;
+}
+
 void CreateSessionDescriptionObserver::OnSuccess(
     webrtc::SessionDescriptionInterface *desc) {
+  if (!_event) {
+    delete desc;
+    return;
+  }
+
+  std::string sdp;
+  desc->ToString(&sdp);
+
   _event->SetSucceeded(true);
-  _event->SetSessionDescription(desc);
-  Globals::GetEventQueue()->PushEvent(_event);
+  _event->SetSessionDescription(desc->type(), sdp);
+  _eventQueue->PushEvent(_event);
+  _event = NULL;
+
+  if (_operationsChain.get()) {
+    _operationsChain->SetLastCreatedDescription(desc, sdp);
+    _operationsChain->Complete();
+  } else {
+    delete desc;
+  }
 }
 
 void CreateSessionDescriptionObserver::OnFailure(const std::string &error) {
+  if (!_event) {
+    return;
+  }
+
   _event->SetSucceeded(false);
   _event->SetErrorMessage(error);
-  Globals::GetEventQueue()->PushEvent(_event);
+  _eventQueue->PushEvent(_event);
+  _event = NULL;
+
+  if (_operationsChain.get()) {
+    _operationsChain->Complete();
+  }
+}
+
+void CreateSessionDescriptionObserver::Abort(const std::string &errorName,
+                                             const std::string &errorMessage) {
+  if (!_event) {
+    return;
+  }
+
+  _event->SetSucceeded(false);
+  _event->SetErrorName(errorName);
+  _event->SetErrorMessage(errorMessage);
+  _eventQueue->PushEvent(_event);
+  _event = NULL;
 }
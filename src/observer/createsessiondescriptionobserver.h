@@ -20,31 +20,44 @@
 #include <nan.h>
 #include <string>
 #include <webrtc/api/peerconnectioninterface.h>
+#include "event/eventqueue.h"
 
 using namespace v8;
 
 class CreateSessionDescriptionEvent;
+class OperationsChain;
 class CreateSessionDescriptionObserver :
     public webrtc::CreateSessionDescriptionObserver {
  public:
   static CreateSessionDescriptionObserver *Create(
-      Persistent<Promise::Resolver> *resolver);
+      Local<Promise::Resolver> resolver);
   static CreateSessionDescriptionObserver *Create(
-      Persistent<Function> *successCallback,
-      Persistent<Function> *failureCallback);
+      Local<Function> successCallback,
+      Local<Function> failureCallback);
+
+  // Set by the operations chain running the observer, which is handed the
+  // created description and told when the operation is complete.
+  void SetOperationsChain(OperationsChain *operationsChain);
 
   void OnSuccess(webrtc::SessionDescriptionInterface* desc);
   void OnFailure(const std::string& error);
 
+  // Fails the operation without waiting for the peer connection, when the
+  // operations chain is closed. Later callbacks are then ignored.
+  void Abort(const std::string& errorName, const std::string& errorMessage);
+
  private:
+  // NULL once handed to the EventQueue, the result is delivered only once.
   CreateSessionDescriptionEvent *_event;
+  rtc::scoped_refptr<EventQueue> _eventQueue;
+  rtc::scoped_refptr<OperationsChain> _operationsChain;
 
  protected:
   explicit CreateSessionDescriptionObserver(
-      Persistent<Promise::Resolver> *resolver);
+      Local<Promise::Resolver> resolver);
 
-  CreateSessionDescriptionObserver(Persistent<Function> *successCallback,
-                                      Persistent<Function> *failureCallback);
+  CreateSessionDescriptionObserver(Local<Function> successCallback,
+                                   Local<Function> failureCallback);
 };
 
 #endif  // OBSERVER_CREATESESSIONDESCRIPTIONOBSERVER_H_
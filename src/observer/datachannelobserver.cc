@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "datachannelobserver.h"
+#include "event/channelbufferedamountevent.h"
+#include "event/channelmessageevent.h"
+#include "event/channelmessagesevent.h"
+#include "event/channelstateevent.h"
+#include "logger.h"
+
+DataChannelObserver::DataChannelObserver(
+    rtc::scoped_refptr<webrtc::DataChannelInterface> dataChannel,
+    rtc::Thread *signalingThread,
+    EventQueue *eventQueue)
+    : _dataChannel(dataChannel),
+      _signalingThread(signalingThread),
+      _eventQueue(eventQueue),
+      _target(NULL),
+      _batchMessages(false),
+      _batch(NULL),
+      _label(dataChannel->label()),
+      _protocol(dataChannel->protocol()),
+      _ordered(dataChannel->ordered()),
+      _negotiated(dataChannel->negotiated()),
+      _maxRetransmitTime(dataChannel->maxRetransmitTime()),
+      _maxRetransmits(dataChannel->maxRetransmits()),
+      _id(dataChannel->id()),
+      _state(dataChannel->state()) {
+}
+
+DataChannelObserver::~DataChannelObserver() {
+  _dataChannel = NULL;
+}
+
+DataChannelObserver *DataChannelObserver::Create(
+    rtc::scoped_refptr<webrtc::DataChannelInterface> dataChannel,
+    rtc::Thread *signalingThread,
+    EventQueue *eventQueue) {
+  DataChannelObserver *observer =
+      new rtc::RefCountedObject<DataChannelObserver>(dataChannel,
+                                                     signalingThread,
+                                                     eventQueue);
+  dataChannel->RegisterObserver(observer);
+  return observer;
+}
+
+void DataChannelObserver::Unregister() {
+  _dataChannel->UnregisterObserver();
+}
+
+rtc::scoped_refptr<webrtc::DataChannelInterface>
+DataChannelObserver::GetDataChannel() const {
+  return _dataChannel;
+}
+
+bool DataChannelObserver::Send(const webrtc::DataBuffer &buffer,
+                               uint64_t *queued) {
+  // Going through the proxy would take one synchronous hop for Send() and
+  // another for buffered_amount(). From the signaling thread, the proxy
+  // calls the channel directly.
+  return _signalingThread->Invoke<bool>(RTC_FROM_HERE, [&]() {
+    uint64_t before = _dataChannel->buffered_amount();
+    bool sent = _dataChannel->Send(buffer);
+    uint64_t after = _dataChannel->buffered_amount();
+    *queued = after > before ? after - before : 0;
+    return sent;
+  });
+}
+
+void DataChannelObserver::SetBatchMessages(bool batchMessages) {
+  rtc::CritScope lock(&_batchLock);
+  _batchMessages.store(batchMessages, std::memory_order_relaxed);
+
+  // A batch still queued must not take the messages received after the
+  // single events queued behind it, they would be delivered out of order.
+  if (!batchMessages) {
+    _batch = NULL;
+  }
+}
+
+bool DataChannelObserver::GetBatchMessages() const {
+  return _batchMessages.load(std::memory_order_relaxed);
+}
+
+void DataChannelObserver::DetachBatch(ChannelMessagesEvent *batch) {
+  rtc::CritScope lock(&_batchLock);
+
+  if (_batch == batch) {
+    _batch = NULL;
+  }
+}
+
+void DataChannelObserver::SetTarget(RTCDataChannel *target) {
+  _target = target;
+}
+
+RTCDataChannel *DataChannelObserver::GetTarget() const {
+  return _target;
+}
+
+const std::string &DataChannelObserver::GetLabel() const {
+  return _label;
+}
+
+const std::string &DataChannelObserver::GetProtocol() const {
+  return _protocol;
+}
+
+bool DataChannelObserver::IsOrdered() const {
+  return _ordered;
+}
+
+bool DataChannelObserver::IsNegotiated() const {
+  return _negotiated;
+}
+
+int DataChannelObserver::GetMaxRetransmitTime() const {
+  return _maxRetransmitTime;
+}
+
+int DataChannelObserver::GetMaxRetransmits() const {
+  return _maxRetransmits;
+}
+
+int DataChannelObserver::GetId() const {
+  return _id;
+}
+
+webrtc::DataChannelInterface::DataState DataChannelObserver::GetState() const {
+  return _state;
+}
+
+void DataChannelObserver::OnStateChange() {
+  webrtc::DataChannelInterface::DataState state = _dataChannel->state();
+
+  LOGGER(kLogDataChannel, kLogVerbose, "OnStateChange: %s %d",
+         _label.c_str(), state);
+  _eventQueue->PushEvent(
+      new ChannelStateEvent(this, state, _dataChannel->id()));
+}
+
+void DataChannelObserver::OnMessage(const webrtc::DataBuffer &buffer) {
+  LOGGER(kLogDataChannel, kLogVerbose, "OnMessage: %s %u", _label.c_str(),
+         static_cast<unsigned int>(buffer.size()));
+
+  if (!_batchMessages.load(std::memory_order_relaxed)) {
+    _eventQueue->PushEvent(new ChannelMessageEvent(this, buffer));
+    return;
+  }
+
+  // Outlives the lock, a closed queue deletes the batch right away and may
+  // drop the last reference to the observer.
+  rtc::scoped_refptr<DataChannelObserver> self(this);
+  rtc::CritScope lock(&_batchLock);
+
+  if (_batch) {
+    _batch->Append(buffer);
+    return;
+  }
+
+  // The event is queued right away, the messages received until it is
+  // handled are appended to it.
+  _batch = new ChannelMessagesEvent(this);
+  _batch->Append(buffer);
+  _eventQueue->PushEvent(_batch);
+}
+
+void DataChannelObserver::OnBufferedAmountChange(uint64_t previous_amount) {
+  uint64_t amount = _dataChannel->buffered_amount();
+
+  if (amount >= previous_amount) {
+    return;
+  }
+
+  LOGGER(kLogDataChannel, kLogVerbose, "OnBufferedAmountChange: %s %llu",
+         _label.c_str(), static_cast<unsigned long long>(amount));  // NOLINT
+  _eventQueue->PushEvent(
+      new ChannelBufferedAmountEvent(this, previous_amount - amount));
+}
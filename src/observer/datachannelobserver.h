@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OBSERVER_DATACHANNELOBSERVER_H_
+#define OBSERVER_DATACHANNELOBSERVER_H_
+
+#include <webrtc/api/datachannelinterface.h>
+#include <webrtc/base/criticalsection.h>
+#include <webrtc/base/thread.h>
+#include <atomic>
+#include <string>
+#include "event/eventqueue.h"
+
+class ChannelMessagesEvent;
+class RTCDataChannel;
+
+// Registers itself on a data channel and forwards its callbacks to the
+// EventQueue of its peer connection. The channel properties which never
+// change are captured once at creation, so that the RTCDataChannel getters
+// do not have to go through the signaling thread proxy.
+class DataChannelObserver : public rtc::RefCountInterface,
+                            public webrtc::DataChannelObserver {
+ public:
+  static DataChannelObserver *Create(
+      rtc::scoped_refptr<webrtc::DataChannelInterface> dataChannel,
+      rtc::Thread *signalingThread,
+      EventQueue *eventQueue);
+
+  // Unregisters from the data channel, no callback will be received anymore.
+  void Unregister();
+
+  rtc::scoped_refptr<webrtc::DataChannelInterface> GetDataChannel() const;
+
+  // Sends |buffer| with a single hop to the signaling thread, and returns in
+  // |queued| how many of its bytes were queued instead of being handed to
+  // the transport right away.
+  bool Send(const webrtc::DataBuffer &buffer, uint64_t *queued);
+
+  // The RTCDataChannel wrapper receiving the events, only accessed from the
+  // main thread.
+  void SetTarget(RTCDataChannel *target);
+  RTCDataChannel *GetTarget() const;
+
+  // In batch mode, messages are coalesced into a ChannelMessagesEvent until
+  // the main thread handles it, instead of one event per message.
+  void SetBatchMessages(bool batchMessages);
+  bool GetBatchMessages() const;
+
+  // Stops appending to |batch| if it is the pending one.
+  void DetachBatch(ChannelMessagesEvent *batch);
+
+  const std::string &GetLabel() const;
+  const std::string &GetProtocol() const;
+  bool IsOrdered() const;
+  bool IsNegotiated() const;
+  int GetMaxRetransmitTime() const;
+  int GetMaxRetransmits() const;
+  int GetId() const;
+  webrtc::DataChannelInterface::DataState GetState() const;
+
+  // The data channel's state has changed.
+  void OnStateChange();
+
+  // A data buffer was successfully received.
+  void OnMessage(const webrtc::DataBuffer &buffer);
+
+  // Queued data has been handed to the transport.
+  void OnBufferedAmountChange(uint64_t previous_amount);
+
+ private:
+  rtc::scoped_refptr<webrtc::DataChannelInterface> _dataChannel;
+  rtc::Thread *_signalingThread;
+  rtc::scoped_refptr<EventQueue> _eventQueue;
+  RTCDataChannel *_target;
+
+  std::atomic<bool> _batchMessages;
+  rtc::CriticalSection _batchLock;
+  ChannelMessagesEvent *_batch;
+
+  std::string _label;
+  std::string _protocol;
+  bool _ordered;
+  bool _negotiated;
+  int _maxRetransmitTime;
+  int _maxRetransmits;
+  int _id;
+  webrtc::DataChannelInterface::DataState _state;
+
+ protected:
+  DataChannelObserver(
+      rtc::scoped_refptr<webrtc::DataChannelInterface> dataChannel,
+      rtc::Thread *signalingThread,
+      EventQueue *eventQueue);
+  ~DataChannelObserver();
+};
+
+#endif  // OBSERVER_DATACHANNELOBSERVER_H_
@@ -14,62 +14,126 @@
  * limitations under the License.
  */
 
-#include <iostream>
+#include "addondata.h"
+#include "datachannelobserver.h"
+#include "event/datachannelevent.h"
+#include "event/icecandidateevent.h"
+#include "event/icecandidatesevent.h"
+#include "event/negotiationneededevent.h"
+#include "event/statechangeevent.h"
+#include "logger.h"
 #include "peerconnectionobserver.h"
 
-PeerConnectionObserver::PeerConnectionObserver() {
+enum {
+  kFlushIceCandidates,
+};
+
+PeerConnectionObserver::PeerConnectionObserver()
+    : _target(NULL),
+      _eventQueue(AddonData::Get()->GetEventQueue()),
+      _signalingThread(NULL),
+      _iceCandidateBatchWindow(0),
+      _iceCandidates(NULL) {
 }
 
 PeerConnectionObserver::~PeerConnectionObserver() {
+  delete _iceCandidates;
   _peerConnection = NULL;
 }
 
 void PeerConnectionObserver::OnSignalingChange(
     webrtc::PeerConnectionInterface::SignalingState new_state) {
-  std::cout << "OnSignalingChange" << std::endl;
+  LOGGER(kLogPeerConnection, kLogVerbose, "OnSignalingChange: %d", new_state);
+  _eventQueue->PushEvent(new StateChangeEvent(
+      this, StateChangeEvent::kSignalingState, new_state));
 }
 
 void PeerConnectionObserver::OnAddStream(
     rtc::scoped_refptr<webrtc::MediaStreamInterface> stream) {
-  std::cout << "OnAddStream" << std::endl;
+  LOGGER(kLogPeerConnection, kLogVerbose, "OnAddStream");
 }
 
 void PeerConnectionObserver::OnRemoveStream(
     rtc::scoped_refptr<webrtc::MediaStreamInterface> stream) {
-  std::cout << "OnRemoveStream" << std::endl;
+  LOGGER(kLogPeerConnection, kLogVerbose, "OnRemoveStream");
 }
 
 void PeerConnectionObserver::OnDataChannel(
     rtc::scoped_refptr<webrtc::DataChannelInterface> data_channel) {
-  std::cout << "OnDataChannel" << std::endl;
+  LOGGER(kLogPeerConnection, kLogVerbose, "OnDataChannel");
+  _eventQueue->PushEvent(new DataChannelEvent(
+      this, DataChannelObserver::Create(data_channel, rtc::Thread::Current(),
+                                        _eventQueue.get())));
 }
 
 void PeerConnectionObserver::OnRenegotiationNeeded() {
-  std::cout << "OnRenegotiationNeeded" << std::endl;
+  LOGGER(kLogPeerConnection, kLogVerbose, "OnRenegotiationNeeded");
+  _eventQueue->PushEvent(new NegotiationNeededEvent(this));
 }
 
 void PeerConnectionObserver::OnIceConnectionChange(
     webrtc::PeerConnectionInterface::IceConnectionState new_state) {
-  std::cout << "OnIceConnectionChange" << std::endl;
+  LOGGER(kLogPeerConnection, kLogVerbose, "OnIceConnectionChange: %d",
+         new_state);
+  _eventQueue->PushEvent(new StateChangeEvent(
+      this, StateChangeEvent::kIceConnectionState, new_state));
 }
 
 void PeerConnectionObserver::OnIceGatheringChange(
     webrtc::PeerConnectionInterface::IceGatheringState new_state) {
-  std::cout << "OnIceGatheringChange" << std::endl;
+  LOGGER(kLogPeerConnection, kLogVerbose, "OnIceGatheringChange: %d",
+         new_state);
+
+  // A closed queue deletes the event right away, which may drop the last
+  // reference to the observer before the end-of-candidates push.
+  rtc::scoped_refptr<PeerConnectionObserver> self(this);
+
+  _eventQueue->PushEvent(new StateChangeEvent(
+      this, StateChangeEvent::kIceGatheringState, new_state));
+
+  if (new_state != webrtc::PeerConnectionInterface::kIceGatheringComplete) {
+    return;
+  }
+
+  // Tell the application that gathering is over, either with a null
+  // candidate or by folding the marker into the last batch.
+  if (_iceCandidateBatchWindow) {
+    FlushIceCandidates(true);
+  } else {
+    _eventQueue->PushEvent(new IceCandidateEvent(this));
+  }
 }
 
 void PeerConnectionObserver::OnIceCandidate(
     const webrtc::IceCandidateInterface *candidate) {
-  std::cout << "OnIceCandidate" << std::endl;
+  LOGGER(kLogPeerConnection, kLogVerbose, "OnIceCandidate: %s %d",
+         candidate->sdp_mid().c_str(), candidate->sdp_mline_index());
+
+  if (_iceCandidateBatchWindow) {
+    if (!_iceCandidates) {
+      _iceCandidates = new IceCandidatesEvent(this);
+      _signalingThread->PostDelayed(RTC_FROM_HERE, _iceCandidateBatchWindow,
+                                    this, kFlushIceCandidates);
+    }
+
+    _iceCandidates->AddCandidate(candidate);
+    return;
+  }
+
+  IceCandidateEvent *event = new IceCandidateEvent(this);
+  event->SetCandidate(candidate);
+  _eventQueue->PushEvent(event);
 }
 
 void PeerConnectionObserver::OnIceCandidatesRemoved(
     const std::vector<cricket::Candidate> &candidates) {
-  std::cout << "OnIceCandidatesRemoved" << std::endl;
+  LOGGER(kLogPeerConnection, kLogVerbose, "OnIceCandidatesRemoved: %u",
+         static_cast<unsigned int>(candidates.size()));
 }
 
 void PeerConnectionObserver::OnIceConnectionReceivingChange(bool receiving) {
-  std::cout << "OnIceConnectionReceivingChange" << std::endl;
+  LOGGER(kLogPeerConnection, kLogVerbose,
+         "OnIceConnectionReceivingChange: %d", receiving);
 }
 
 PeerConnectionObserver *PeerConnectionObserver::Create() {
@@ -80,3 +144,51 @@ void PeerConnectionObserver::SetPeerConnection(
     rtc::scoped_refptr<webrtc::PeerConnectionInterface> peerConnection) {
   _peerConnection = peerConnection;
 }
+
+void PeerConnectionObserver::SetTarget(RTCPeerConnection *target) {
+  _target = target;
+}
+
+RTCPeerConnection *PeerConnectionObserver::GetTarget() const {
+  return _target;
+}
+
+EventQueue *PeerConnectionObserver::GetEventQueue() const {
+  return _eventQueue.get();
+}
+
+void PeerConnectionObserver::SetIceCandidateBatchWindow(
+    rtc::Thread *signalingThread, uint32_t window) {
+  _signalingThread = signalingThread;
+  _iceCandidateBatchWindow = window;
+}
+
+void PeerConnectionObserver::OnMessage(rtc::Message *msg) {
+  switch (msg->message_id) {
+    case kFlushIceCandidates:
+      FlushIceCandidates(false);
+      break;
+  }
+}
+
+void PeerConnectionObserver::FlushIceCandidates(bool endOfCandidates) {
+  _signalingThread->Clear(this, kFlushIceCandidates);
+
+  if (!_iceCandidates) {
+    if (!endOfCandidates) {
+      return;
+    }
+
+    _iceCandidates = new IceCandidatesEvent(this);
+  }
+
+  if (endOfCandidates) {
+    _iceCandidates->SetEndOfCandidates();
+  }
+
+  LOGGER(kLogPeerConnection, kLogVerbose, "FlushIceCandidates: %d",
+         endOfCandidates);
+  IceCandidatesEvent *event = _iceCandidates;
+  _iceCandidates = NULL;
+  _eventQueue->PushEvent(event);
+}
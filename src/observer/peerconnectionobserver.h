@@ -18,8 +18,16 @@
 #define OBSERVER_PEERCONNECTIONOBSERVER_H_
 
 #include <webrtc/api/peerconnectioninterface.h>
+#include <webrtc/base/messagehandler.h>
+#include <webrtc/base/thread.h>
+#include <vector>
+#include "event/eventqueue.h"
+
+class IceCandidatesEvent;
+class RTCPeerConnection;
 
 class PeerConnectionObserver : public rtc::RefCountInterface,
+                               public rtc::MessageHandler,
                                public webrtc::PeerConnectionObserver {
  public:
   static PeerConnectionObserver *Create();
@@ -27,6 +35,23 @@ class PeerConnectionObserver : public rtc::RefCountInterface,
   void SetPeerConnection(
       rtc::scoped_refptr<webrtc::PeerConnectionInterface> peerConnection);
 
+  // The RTCPeerConnection wrapper receiving the events. Only accessed from
+  // the main thread, it is reset to NULL when the wrapper is destroyed so
+  // that events still sitting in the queue are dropped.
+  void SetTarget(RTCPeerConnection *target);
+  RTCPeerConnection *GetTarget() const;
+
+  // The queue of the environment which created the observer, every event
+  // of the connection and its data channels goes through it.
+  EventQueue *GetEventQueue() const;
+
+  // Enables batched ICE candidate delivery: candidates are collected on the
+  // signaling thread for up to |window| milliseconds, or until gathering
+  // completes, then delivered in a single onicecandidates event. Must be
+  // called before the peer connection is created.
+  void SetIceCandidateBatchWindow(rtc::Thread *signalingThread,
+                                  uint32_t window);
+
   // Triggered when the SignalingState changed.
   void OnSignalingChange(
       webrtc::PeerConnectionInterface::SignalingState new_state);
@@ -65,8 +90,20 @@ class PeerConnectionObserver : public rtc::RefCountInterface,
   // Called when the ICE connection receiving status changes.
   void OnIceConnectionReceivingChange(bool receiving);
 
+  // Flushes the pending ICE candidate batch when its window elapses.
+  void OnMessage(rtc::Message *msg);
+
  private:
   rtc::scoped_refptr<webrtc::PeerConnectionInterface> _peerConnection;
+  RTCPeerConnection *_target;
+  rtc::scoped_refptr<EventQueue> _eventQueue;
+
+  void FlushIceCandidates(bool endOfCandidates);
+
+  // Only touched from the signaling thread once the peer connection exists.
+  rtc::Thread *_signalingThread;
+  uint32_t _iceCandidateBatchWindow;
+  IceCandidatesEvent *_iceCandidates;
 
  protected:
   PeerConnectionObserver();
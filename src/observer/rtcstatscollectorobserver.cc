@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "addondata.h"
+#include "event/getstatsevent.h"
+#include "rtcstatscollectorobserver.h"
+
+RTCStatsCollectorObserver::RTCStatsCollectorObserver(GetStatsEvent *event)
+    : _event(event),
+      _eventQueue(AddonData::Get()->GetEventQueue()) {
+}
+
+RTCStatsCollectorObserver *RTCStatsCollectorObserver::Create(
+    GetStatsEvent *event) {
+  return new rtc::RefCountedObject<RTCStatsCollectorObserver>(event);
+}
+
+void RTCStatsCollectorObserver::OnStatsDelivered(
+    const rtc::scoped_refptr<const webrtc::RTCStatsReport> &report) {
+  _event->SetReport(*report);
+  _eventQueue->PushEvent(_event);
+}
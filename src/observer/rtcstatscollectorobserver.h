@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OBSERVER_RTCSTATSCOLLECTOROBSERVER_H_
+#define OBSERVER_RTCSTATSCOLLECTOROBSERVER_H_
+
+#include <webrtc/api/stats/rtcstatscollectorcallback.h>
+#include "event/eventqueue.h"
+
+class GetStatsEvent;
+
+// Receives a stats report on the signaling thread, copies what the event
+// needs out of it there and hands the event to the EventQueue of the
+// environment which asked for it.
+class RTCStatsCollectorObserver : public webrtc::RTCStatsCollectorCallback {
+ public:
+  static RTCStatsCollectorObserver *Create(GetStatsEvent *event);
+
+  void OnStatsDelivered(
+      const rtc::scoped_refptr<const webrtc::RTCStatsReport> &report);
+
+ private:
+  GetStatsEvent *_event;
+  rtc::scoped_refptr<EventQueue> _eventQueue;
+
+ protected:
+  explicit RTCStatsCollectorObserver(GetStatsEvent *event);
+};
+
+#endif  // OBSERVER_RTCSTATSCOLLECTOROBSERVER_H_
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "addondata.h"
+#include "common.h"
+#include "event/setsessiondescriptionevent.h"
+#include "operationschain.h"
+#include "setsessiondescriptionobserver.h"
+
+using namespace v8;
+
+SetSessionDescriptionObserver::SetSessionDescriptionObserver(
+    Local<Promise::Resolver> resolver)
+    : _eventQueue(AddonData::Get()->GetEventQueue()) {
+  _event = new SetSessionDescriptionEvent(resolver);
+}
+
+SetSessionDescriptionObserver::SetSessionDescriptionObserver(
+    Local<Function> successCallback,
+    Local<Function> failureCallback)
+    : _eventQueue(AddonData::Get()->GetEventQueue()) {
+  _event = new SetSessionDescriptionEvent(successCallback, failureCallback);
+}
+
+SetSessionDescriptionObserver *SetSessionDescriptionObserver::
+  Create(Local<Function> successCallback,
+         Local<Function> failureCallback) {
+  return new rtc::RefCountedObject<SetSessionDescriptionObserver>
+      (successCallback, failureCallback);
+}
+
+SetSessionDescriptionObserver *SetSessionDescriptionObserver::
+  Create(Local<Promise::Resolver> resolver) {
+  return new rtc::RefCountedObject<SetSessionDescriptionObserver>
+      (resolver);
+}
+
+void SetSessionDescriptionObserver::SetOperationsChain(
+    OperationsChain *operationsChain) {
+  _operationsChain = operationsChain;
+}
+
+void SetSessionDescriptionObserver::OnSuccess() {
+  if (!_event) {
+    return;
+  }
+
+  _event->SetSucceeded(true);
+  _eventQueue->PushEvent(_event);
+  _event = NULL;
+
+  if (_operationsChain.get()) {
+    _operationsChain->Complete();
+  }
+}
+
+void SetSessionDescriptionObserver::OnFailure(const std::string &error) {
+  if (!_event) {
+    return;
+  }
+
+  _event->SetSucceeded(false);
+  _event->SetErrorMessage(error);
+  _eventQueue->PushEvent(_event);
+  _event = NULL;
+
+  if (_operationsChain.get()) {
+    _operationsChain->Complete();
+  }
+}
+
+void SetSessionDescriptionObserver::Abort(const std::string &errorName,
+                                          const std::string &errorMessage) {
+  if (!_event) {
+    return;
+  }
+
+  _event->SetSucceeded(false);
+  _event->SetErrorName(errorName);
+  _event->SetErrorMessage(errorMessage);
+  _eventQueue->PushEvent(_event);
+  _event = NULL;
+}
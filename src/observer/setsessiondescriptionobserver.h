@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OBSERVER_SETSESSIONDESCRIPTIONOBSERVER_H_
+#define OBSERVER_SETSESSIONDESCRIPTIONOBSERVER_H_
+
+#include <nan.h>
+#include <string>
+#include <webrtc/api/peerconnectioninterface.h>
+#include "event/eventqueue.h"
+
+using namespace v8;
+
+class OperationsChain;
+class SetSessionDescriptionEvent;
+class SetSessionDescriptionObserver :
+    public webrtc::SetSessionDescriptionObserver {
+ public:
+  static SetSessionDescriptionObserver *Create(
+      Local<Promise::Resolver> resolver);
+  static SetSessionDescriptionObserver *Create(
+      Local<Function> successCallback,
+      Local<Function> failureCallback);
+
+  // Set by the operations chain running the observer, which is told when
+  // the operation is complete.
+  void SetOperationsChain(OperationsChain *operationsChain);
+
+  void OnSuccess();
+  void OnFailure(const std::string& error);
+
+  // Fails the operation without waiting for the peer connection, when the
+  // operations chain is closed. Later callbacks are then ignored.
+  void Abort(const std::string& errorName, const std::string& errorMessage);
+
+ private:
+  // NULL once handed to the EventQueue, the result is delivered only once.
+  SetSessionDescriptionEvent *_event;
+  rtc::scoped_refptr<EventQueue> _eventQueue;
+  rtc::scoped_refptr<OperationsChain> _operationsChain;
+
+ protected:
+  explicit SetSessionDescriptionObserver(
+      Local<Promise::Resolver> resolver);
+
+  SetSessionDescriptionObserver(Local<Function> successCallback,
+                                Local<Function> failureCallback);
+};
+
+#endif  // OBSERVER_SETSESSIONDESCRIPTIONOBSERVER_H_
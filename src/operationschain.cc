@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <webrtc/api/test/fakeconstraints.h>
+#include <webrtc/base/messagequeue.h>
+#include "observer/createsessiondescriptionobserver.h"
+#include "observer/setsessiondescriptionobserver.h"
+#include "operationschain.h"
+
+static const char eParse[] = "Failed to parse SessionDescription. ";
+static const char eClosed[] =
+    "The RTCPeerConnection's signalingState is 'closed'.";
+static const char kInvalidStateError[] = "InvalidStateError";
+
+enum {
+  kChain,
+  kRunNext,
+};
+
+// Creates the description of an implicit setLocalDescription, then sets it.
+class ImplicitDescriptionObserver :
+    public webrtc::CreateSessionDescriptionObserver {
+ public:
+  ImplicitDescriptionObserver(
+      rtc::scoped_refptr<webrtc::PeerConnectionInterface> peerConnection,
+      SetSessionDescriptionObserver *observer)
+      : _peerConnection(peerConnection),
+        _observer(observer) {
+  }
+
+  void OnSuccess(webrtc::SessionDescriptionInterface *desc) {
+    _peerConnection->SetLocalDescription(_observer, desc);
+  }
+
+  void OnFailure(const std::string &error) {
+    _observer->OnFailure(error);
+  }
+
+ private:
+  rtc::scoped_refptr<webrtc::PeerConnectionInterface> _peerConnection;
+  rtc::scoped_refptr<SetSessionDescriptionObserver> _observer;
+};
+
+static void CreateDescription(
+    webrtc::PeerConnectionInterface *peerConnection, const std::string &type,
+    bool iceRestart, webrtc::CreateSessionDescriptionObserver *observer) {
+  webrtc::FakeConstraints constraints;
+
+  if (type == webrtc::SessionDescriptionInterface::kOffer) {
+    constraints.AddOptional(webrtc::MediaConstraintsInterface::kIceRestart,
+                            iceRestart);
+    peerConnection->CreateOffer(observer, &constraints);
+  } else {
+    peerConnection->CreateAnswer(observer, &constraints);
+  }
+}
+
+CreateDescriptionOperation::CreateDescriptionOperation(
+    const std::string &type, bool iceRestart,
+    CreateSessionDescriptionObserver *observer)
+    : _type(type),
+      _iceRestart(iceRestart),
+      _observer(observer) {
+}
+
+void CreateDescriptionOperation::Run(
+    OperationsChain *chain, webrtc::PeerConnectionInterface *peerConnection) {
+  _observer->SetOperationsChain(chain);
+  CreateDescription(peerConnection, _type, _iceRestart, _observer);
+}
+
+void CreateDescriptionOperation::Abort() {
+  _observer->Abort(kInvalidStateError, eClosed);
+}
+
+SetDescriptionOperation::SetDescriptionOperation(
+    bool local, const std::string &type, const std::string &sdp,
+    SetSessionDescriptionObserver *observer)
+    : _local(local),
+      _type(type),
+      _sdp(sdp),
+      _observer(observer) {
+}
+
+void SetDescriptionOperation::Run(
+    OperationsChain *chain, webrtc::PeerConnectionInterface *peerConnection) {
+  webrtc::SessionDescriptionInterface *desc = NULL;
+
+  _observer->SetOperationsChain(chain);
+
+  if (_local && _type.empty()) {
+    webrtc::PeerConnectionInterface::SignalingState state =
+        peerConnection->signaling_state();
+
+    if (state == webrtc::PeerConnectionInterface::kHaveRemoteOffer ||
+        state == webrtc::PeerConnectionInterface::kHaveLocalPrAnswer) {
+      _type = webrtc::SessionDescriptionInterface::kAnswer;
+    } else {
+      _type = webrtc::SessionDescriptionInterface::kOffer;
+    }
+
+    desc = chain->TakeLastCreatedDescription(_type, NULL);
+
+    if (!desc) {
+      rtc::scoped_refptr<ImplicitDescriptionObserver> observer(
+          new rtc::RefCountedObject<ImplicitDescriptionObserver>(
+              peerConnection, _observer));
+      CreateDescription(peerConnection, _type, false, observer);
+      return;
+    }
+  } else if (_local) {
+    desc = chain->TakeLastCreatedDescription(_type, &_sdp);
+  }
+
+  if (!desc) {
+    webrtc::SdpParseError error;
+    desc = webrtc::CreateSessionDescription(_type, _sdp, &error);
+
+    if (!desc) {
+      _observer->OnFailure(eParse + error.description);
+      return;
+    }
+  }
+
+  if (_local) {
+    peerConnection->SetLocalDescription(_observer, desc);
+  } else {
+    peerConnection->SetRemoteDescription(_observer, desc);
+  }
+}
+
+void SetDescriptionOperation::Abort() {
+  _observer->Abort(kInvalidStateError, eClosed);
+}
+
+OperationsChain::OperationsChain(
+    rtc::Thread *signalingThread,
+    rtc::scoped_refptr<webrtc::PeerConnectionInterface> peerConnection)
+    : _signalingThread(signalingThread),
+      _peerConnection(peerConnection),
+      _current(NULL),
+      _closed(false) {
+}
+
+OperationsChain::~OperationsChain() {
+  delete _current;
+
+  for (size_t i = 0; i < _operations.size(); ++i) {
+    delete _operations[i];
+  }
+}
+
+OperationsChain *OperationsChain::Create(
+    rtc::Thread *signalingThread,
+    rtc::scoped_refptr<webrtc::PeerConnectionInterface> peerConnection) {
+  return new rtc::RefCountedObject<OperationsChain>(signalingThread,
+                                                    peerConnection);
+}
+
+void OperationsChain::Chain(Operation *operation) {
+  _signalingThread->Post(RTC_FROM_HERE, this, kChain,
+                         new rtc::ScopedMessageData<Operation>(operation));
+}
+
+void OperationsChain::Complete() {
+  if (_closed) {
+    return;
+  }
+
+  // Posted rather than run from here, the observer may still be inside the
+  // peer connection call which completed the operation.
+  _signalingThread->Post(RTC_FROM_HERE, this, kRunNext);
+}
+
+void OperationsChain::Close() {
+  _signalingThread->Invoke<void>(RTC_FROM_HERE, [this]() {
+    rtc::MessageList removed;
+    _signalingThread->Clear(this, rtc::MQID_ANY, &removed);
+
+    // The running operation first, so that the results are still delivered
+    // in the order the operations were chained.
+    if (_current) {
+      AbortOperation(_current);
+      _current = NULL;
+    }
+
+    for (size_t i = 0; i < _operations.size(); ++i) {
+      AbortOperation(_operations[i]);
+    }
+
+    _operations.clear();
+
+    for (rtc::MessageList::iterator it = removed.begin();
+         it != removed.end(); ++it) {
+      if (it->message_id == kChain) {
+        rtc::ScopedMessageData<Operation> *data =
+            static_cast<rtc::ScopedMessageData<Operation> *>(it->pdata);
+        AbortOperation(data->release());
+      }
+
+      delete it->pdata;
+    }
+
+    _lastCreated.reset();
+    _peerConnection = NULL;
+    _closed = true;
+  });
+}
+
+void OperationsChain::SetLastCreatedDescription(
+    webrtc::SessionDescriptionInterface *desc, const std::string &sdp) {
+  _lastCreated.reset(desc);
+  _lastCreatedSdp = sdp;
+}
+
+webrtc::SessionDescriptionInterface *OperationsChain::
+  TakeLastCreatedDescription(const std::string &type, const std::string *sdp) {
+  if (!_lastCreated || _lastCreated->type() != type ||
+      (sdp && *sdp != _lastCreatedSdp)) {
+    return NULL;
+  }
+
+  _lastCreatedSdp.clear();
+  return _lastCreated.release();
+}
+
+void OperationsChain::OnMessage(rtc::Message *msg) {
+  switch (msg->message_id) {
+    case kChain: {
+      rtc::ScopedMessageData<Operation> *data =
+          static_cast<rtc::ScopedMessageData<Operation> *>(msg->pdata);
+
+      if (_closed) {
+        AbortOperation(data->release());
+        delete data;
+        break;
+      }
+
+      _operations.push_back(data->release());
+      delete data;
+
+      if (!_current) {
+        RunNext();
+      }
+
+      break;
+    }
+
+    case kRunNext:
+      delete _current;
+      _current = NULL;
+      RunNext();
+      break;
+  }
+}
+
+void OperationsChain::RunNext() {
+  if (_closed || _operations.empty()) {
+    return;
+  }
+
+  // Kept until it completes, so that it can still be aborted.
+  _current = _operations.front();
+  _operations.pop_front();
+  _current->Run(this, _peerConnection.get());
+}
+
+void OperationsChain::AbortOperation(Operation *operation) {
+  operation->Abort();
+  delete operation;
+}
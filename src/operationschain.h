@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OPERATIONSCHAIN_H_
+#define OPERATIONSCHAIN_H_
+
+#include <webrtc/api/jsep.h>
+#include <webrtc/api/peerconnectioninterface.h>
+#include <webrtc/base/messagehandler.h>
+#include <webrtc/base/refcount.h>
+#include <webrtc/base/thread.h>
+#include <deque>
+#include <memory>
+#include <string>
+
+class CreateSessionDescriptionObserver;
+class OperationsChain;
+class SetSessionDescriptionObserver;
+
+// One step of the operations chain. It is run on the signaling thread, its
+// observer completes the operation later on.
+class Operation {
+ public:
+  virtual ~Operation() {}
+
+  virtual void Run(OperationsChain *chain,
+                   webrtc::PeerConnectionInterface *peerConnection) = 0;
+
+  // Fails the operation with an InvalidStateError, when the chain is closed
+  // before it has run or completed.
+  virtual void Abort() = 0;
+};
+
+// Creates an offer or an answer, which is kept as the last created
+// description of the chain.
+class CreateDescriptionOperation : public Operation {
+ public:
+  CreateDescriptionOperation(const std::string &type, bool iceRestart,
+                             CreateSessionDescriptionObserver *observer);
+
+  void Run(OperationsChain *chain,
+           webrtc::PeerConnectionInterface *peerConnection);
+  void Abort();
+
+ private:
+  const std::string _type;
+  const bool _iceRestart;
+  rtc::scoped_refptr<CreateSessionDescriptionObserver> _observer;
+};
+
+// Applies a local or a remote description. The SDP is parsed on the
+// signaling thread, unless it is the one of the last created description.
+// A local description with an empty type is implicit: the last created
+// offer or answer is used, depending on the signaling state, one being
+// created first when there is none.
+class SetDescriptionOperation : public Operation {
+ public:
+  SetDescriptionOperation(bool local, const std::string &type,
+                          const std::string &sdp,
+                          SetSessionDescriptionObserver *observer);
+
+  void Run(OperationsChain *chain,
+           webrtc::PeerConnectionInterface *peerConnection);
+  void Abort();
+
+ private:
+  const bool _local;
+  std::string _type;
+  const std::string _sdp;
+  rtc::scoped_refptr<SetSessionDescriptionObserver> _observer;
+};
+
+// The operations chain of a connection: createOffer, createAnswer,
+// setLocalDescription and setRemoteDescription run one after the other on
+// the signaling thread, each one once the previous has completed. Chaining
+// does not wait for the main thread, so JavaScript may call setLocalDescription
+// right after createOffer without awaiting it.
+class OperationsChain : public rtc::RefCountInterface,
+                        public rtc::MessageHandler {
+ public:
+  static OperationsChain *Create(
+      rtc::Thread *signalingThread,
+      rtc::scoped_refptr<webrtc::PeerConnectionInterface> peerConnection);
+
+  // Appends an operation and takes ownership of it. May be called from any
+  // thread.
+  void Chain(Operation *operation);
+
+  // Called from the signaling thread by the observer of the running
+  // operation, once its result has been handed to the EventQueue.
+  void Complete();
+
+  // Fails the running operation and the ones not run yet, then releases the
+  // peer connection. Blocks on the signaling thread, no operation runs once
+  // it returns.
+  void Close();
+
+  // Keeps the description created by the last createOffer or createAnswer,
+  // taking ownership of it.
+  void SetLastCreatedDescription(webrtc::SessionDescriptionInterface *desc,
+                                 const std::string &sdp);
+
+  // Hands over the last created description when it has |type|, and
+  // |sdp| when given. NULL otherwise.
+  webrtc::SessionDescriptionInterface *TakeLastCreatedDescription(
+      const std::string &type, const std::string *sdp);
+
+  void OnMessage(rtc::Message *msg);
+
+ protected:
+  OperationsChain(
+      rtc::Thread *signalingThread,
+      rtc::scoped_refptr<webrtc::PeerConnectionInterface> peerConnection);
+  ~OperationsChain();
+
+ private:
+  void RunNext();
+  void AbortOperation(Operation *operation);
+
+  rtc::Thread *_signalingThread;
+
+  // Only touched from the signaling thread.
+  rtc::scoped_refptr<webrtc::PeerConnectionInterface> _peerConnection;
+  std::deque<Operation *> _operations;
+  Operation *_current;
+  bool _closed;
+  std::unique_ptr<webrtc::SessionDescriptionInterface> _lastCreated;
+  std::string _lastCreatedSdp;
+};
+
+#endif  // OPERATIONSCHAIN_H_
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include "addondata.h"
+#include "paralleljob.h"
+
+ParallelJob::ParallelJob()
+    : _loop(Nan::GetCurrentEventLoop()),
+      _eventQueue(AddonData::Get()->GetEventQueue()),
+      _count(0),
+      _running(0),
+      _pending(0) {
+  _prepare.data = this;
+}
+
+ParallelJob::~ParallelJob() {
+}
+
+EventQueue *ParallelJob::GetEventQueue() const {
+  return _eventQueue.get();
+}
+
+void ParallelJob::Start() {
+  uv_queue_work(_loop, &_prepare, PrepareWork, AfterPrepare);
+}
+
+size_t ParallelJob::GetChunkCount(size_t count) {
+  size_t threads = kDefaultThreadpoolSize;
+  const char *threadpoolSize = getenv("UV_THREADPOOL_SIZE");
+
+  if (threadpoolSize && atoi(threadpoolSize) > 0) {
+    threads = static_cast<size_t>(atoi(threadpoolSize));
+  }
+
+  size_t chunks = (count + kMinChunkSize - 1) / kMinChunkSize;
+  return std::max<size_t>(1, std::min(threads, chunks));
+}
+
+void ParallelJob::PrepareWork(uv_work_t *request) {
+  ParallelJob *self = static_cast<ParallelJob *>(request->data);
+  self->_count = self->Prepare();
+}
+
+void ParallelJob::AfterPrepare(uv_work_t *request, int status) {
+  ParallelJob *self = static_cast<ParallelJob *>(request->data);
+  size_t chunkCount = GetChunkCount(self->_count);
+
+  // Sized once, the requests must not move while queued.
+  self->_chunks.resize(chunkCount);
+  self->_running = chunkCount;
+  self->_pending = chunkCount;
+
+  for (size_t i = 0; i < chunkCount; ++i) {
+    Chunk &chunk = self->_chunks[i];
+
+    chunk.request.data = &chunk;
+    chunk.job = self;
+    chunk.begin = self->_count * i / chunkCount;
+    chunk.end = self->_count * (i + 1) / chunkCount;
+
+    uv_queue_work(self->_loop, &chunk.request, RunWork, AfterRun);
+  }
+}
+
+void ParallelJob::RunWork(uv_work_t *request) {
+  Chunk *chunk = static_cast<Chunk *>(request->data);
+  ParallelJob *self = chunk->job;
+
+  self->Run(chunk->begin, chunk->end);
+
+  if (self->_running.fetch_sub(1) == 1) {
+    self->Finish();
+  }
+}
+
+void ParallelJob::AfterRun(uv_work_t *request, int status) {
+  Chunk *chunk = static_cast<Chunk *>(request->data);
+  ParallelJob *self = chunk->job;
+
+  if (--self->_pending == 0) {
+    delete self;
+  }
+}
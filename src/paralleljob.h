@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PARALLELJOB_H_
+#define PARALLELJOB_H_
+
+#include <uv.h>
+#include <webrtc/base/scoped_ref_ptr.h>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include "event/eventqueue.h"
+
+// A job spread over the libuv threadpool. Prepare() runs first and returns
+// the number of items, Run() is then called on several threads with
+// disjoint ranges of items, and Finish() runs on the thread which completed
+// the last range. The job must be created and started from a JavaScript
+// thread, it deletes itself there once done. Results are usually handed back
+// by pushing an event from Finish() to the queue of that thread.
+class ParallelJob {
+ public:
+  ParallelJob();
+  virtual ~ParallelJob();
+
+  void Start();
+
+ protected:
+  virtual size_t Prepare() = 0;
+  virtual void Run(size_t begin, size_t end) = 0;
+  virtual void Finish() = 0;
+
+  EventQueue *GetEventQueue() const;
+
+ private:
+  struct Chunk {
+    uv_work_t request;
+    ParallelJob *job;
+    size_t begin;
+    size_t end;
+  };
+
+  static size_t GetChunkCount(size_t count);
+
+  static void PrepareWork(uv_work_t *request);
+  static void AfterPrepare(uv_work_t *request, int status);
+  static void RunWork(uv_work_t *request);
+  static void AfterRun(uv_work_t *request, int status);
+
+  uv_loop_t *_loop;
+  rtc::scoped_refptr<EventQueue> _eventQueue;
+  uv_work_t _prepare;
+  size_t _count;
+  std::vector<Chunk> _chunks;
+  std::atomic<size_t> _running;
+  size_t _pending;
+
+  static const size_t kMinChunkSize = 16;
+  static const size_t kDefaultThreadpoolSize = 4;
+};
+
+#endif  // PARALLELJOB_H_
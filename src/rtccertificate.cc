@@ -14,10 +14,15 @@
  * limitations under the License.
  */
 
+#include <ctime>
 #include <iostream>
+#include <webrtc/base/messagedigest.h>
 #include <webrtc/base/rtccertificate.h>
-#include "rtccertificate.h"
+#include <webrtc/base/stringencode.h>
+#include <vector>
+#include "certificatestore.h"
 #include "common.h"
+#include "rtccertificate.h"
 
 static const char sRTCCertificate[] = "RTCCertificate";
 
@@ -29,9 +34,24 @@ static const char kPrivateKey[] = "privateKey";
 static const char kCertificate[] = "certificate";
 static const char kFromPEM[] = "fromPEM";
 static const char kToPEM[] = "toPEM";
+static const char kLoad[] = "load";
+
+// SHA-256 comes first, it is the digest generated certificates are signed
+// with and the one advertised in the SDP.
+static const char *const kFingerprintAlgorithms[] = {
+  rtc::DIGEST_SHA_256,
+  rtc::DIGEST_SHA_384,
+  rtc::DIGEST_SHA_512,
+  rtc::DIGEST_SHA_1,
+};
+static const char kSave[] = "save";
 
 static const char eImport[] =
     "Failed to import the PEM certificate.";
+static const char eIllegalConstructor[] = "Illegal constructor";
+static const char ePath[] = "parameter 1 ('path') is not a string.";
+static const char eCertificates[] =
+    "parameter 2 ('certificates') is not an array of RTCCertificate.";
 
 NAN_MODULE_INIT(RTCCertificate::Init) {
   Local<FunctionTemplate> ctor = Nan::New<FunctionTemplate>(New);
@@ -39,6 +59,8 @@ NAN_MODULE_INIT(RTCCertificate::Init) {
   ctor->InstanceTemplate()->SetInternalFieldCount(1);
 
   Nan::SetMethod(ctor, kFromPEM, FromPEM);
+  Nan::SetMethod(ctor, kLoad, Load);
+  Nan::SetMethod(ctor, kSave, Save);
 
   Local<ObjectTemplate> prototype = ctor->PrototypeTemplate();
   Nan::SetAccessor(prototype, LOCAL_STRING(kExpires), GetExpires);
@@ -47,6 +69,7 @@ NAN_MODULE_INIT(RTCCertificate::Init) {
   Nan::SetMethod(prototype, kToPEM, ToPEM);
 
   constructor().Reset(Nan::GetFunction(ctor).ToLocalChecked());
+  functionTemplate().Reset(ctor);
 
   Nan::Set(target, LOCAL_STRING(sRTCCertificate), ctor->GetFunction());
 }
@@ -57,20 +80,54 @@ RTCCertificate::RTCCertificate(
 }
 
 RTCCertificate::~RTCCertificate() {
+  _fingerprintsArray.Reset();
+}
+
+static void Freeze(Local<Object> object) {
+  object->SetIntegrityLevel(Nan::GetCurrentContext(), IntegrityLevel::kFrozen)
+      .FromJust();
 }
 
 Local<Object> RTCCertificate::Create(
     const rtc::scoped_refptr<rtc::RTCCertificate>& certificate) {
   Local<Function> cons = Nan::New(RTCCertificate::constructor());
-  Local<Object> instance = Nan::NewInstance(cons, 0, NULL).ToLocalChecked();
 
-  RTCCertificate *rtcCertificate = new RTCCertificate(certificate);
-  rtcCertificate->Wrap(instance);
+  const int argc = 1;
+  Local<Value> argv[1] = { Nan::New<External>(certificate.get()) };
+  return Nan::NewInstance(cons, argc, argv).ToLocalChecked();
+}
+
+bool RTCCertificate::HasInstance(Local<Value> value) {
+  return Nan::New(functionTemplate())->HasInstance(value);
+}
+
+uint64_t RTCCertificate::Now() {
+  return static_cast<uint64_t>(time(NULL)) * 1000;
+}
 
-  return instance;
+const rtc::scoped_refptr<rtc::RTCCertificate>&
+    RTCCertificate::GetCertificate() const {
+  return _certificate;
 }
 
 NAN_METHOD(RTCCertificate::New) {
+  CONSTRUCTOR_HEADER("RTCCertificate");
+  ASSERT_CONSTRUCT_CALL;
+
+  // Certificates are only created by generateCertificate() and fromPEM(),
+  // which pass them as an External, so that every instance is wrapped.
+  if (info.Length() != 1 || !info[0]->IsExternal()) {
+    errorStream << eIllegalConstructor;
+    return Nan::ThrowTypeError(errorStream.str().c_str());
+  }
+
+  rtc::RTCCertificate *certificate = static_cast<rtc::RTCCertificate *>(
+      info[0].As<External>()->Value());
+
+  RTCCertificate *rtcCertificate = new RTCCertificate(certificate);
+  rtcCertificate->Wrap(info.This());
+
+  info.GetReturnValue().Set(info.This());
 }
 
 NAN_GETTER(RTCCertificate::GetExpires) {
@@ -83,21 +140,36 @@ NAN_GETTER(RTCCertificate::GetExpires) {
 NAN_GETTER(RTCCertificate::GetFingerprints) {
   UNWRAP_OBJECT(RTCCertificate, object);
 
-  const rtc::SSLCertificate &sslCertificate =
-      object->_certificate->ssl_certificate();
-  const std::string algorithm =
-      sslCertificate.GetStats()->fingerprint_algorithm;
-  const std::string value =
-      sslCertificate.GetStats()->fingerprint;
-
-  Local<Object> fingerprint = Nan::New<Object>();
-  Local<Array> array = Nan::New<Array>();
-
-  fingerprint->Set(LOCAL_STRING(kAlgorithm), LOCAL_STRING(algorithm));
-  fingerprint->Set(LOCAL_STRING(kValue), LOCAL_STRING(value));
-  array->Set(0, fingerprint);
+  if (object->_fingerprintsArray.IsEmpty()) {
+    const rtc::SSLCertificate &sslCertificate =
+        object->_certificate->ssl_certificate();
+    unsigned char digest[rtc::MessageDigest::kMaxSize];
+    Local<Array> array = Nan::New<Array>();
+    uint32_t index = 0;
+
+    for (const char *algorithm : kFingerprintAlgorithms) {
+      size_t length;
+
+      if (!sslCertificate.ComputeDigest(algorithm, digest, sizeof(digest),
+                                        &length)) {
+        continue;
+      }
+
+      Local<Object> fingerprint = Nan::New<Object>();
+
+      fingerprint->Set(LOCAL_STRING(kAlgorithm), LOCAL_STRING(algorithm));
+      fingerprint->Set(LOCAL_STRING(kValue), LOCAL_STRING(
+          rtc::hex_encode_with_delimiter(reinterpret_cast<char *>(digest),
+                                         length, ':')));
+      Freeze(fingerprint);
+      array->Set(index++, fingerprint);
+    }
+
+    Freeze(array);
+    object->_fingerprintsArray.Reset(array);
+  }
 
-  info.GetReturnValue().Set(array);
+  info.GetReturnValue().Set(Nan::New(object->_fingerprintsArray));
 }
 
 NAN_METHOD(RTCCertificate::ToPEM) {
@@ -138,3 +210,61 @@ NAN_METHOD(RTCCertificate::FromPEM) {
 
   info.GetReturnValue().Set(RTCCertificate::Create(rtcCertificate));
 }
+
+NAN_METHOD(RTCCertificate::Load) {
+  METHOD_HEADER("RTCCertificate", "load");
+  DECLARE_PROMISE_RESOLVER;
+
+  // Non-standard: loads the certificates saved by RTCCertificate.save().
+  if (info.Length() < 1 || !info[0]->IsString()) {
+    errorStream << ePath;
+    resolver->Reject(Nan::GetCurrentContext(),
+                     Nan::TypeError(errorStream.str().c_str()));
+    return;
+  }
+
+  String::Utf8Value path(info[0]->ToString());
+  CertificateStore::Load(*path, resolver);
+}
+
+NAN_METHOD(RTCCertificate::Save) {
+  METHOD_HEADER("RTCCertificate", "save");
+  DECLARE_PROMISE_RESOLVER;
+
+  // Non-standard: saves the certificates to a single file, replacing it.
+  if (info.Length() < 1 || !info[0]->IsString()) {
+    errorStream << ePath;
+    resolver->Reject(Nan::GetCurrentContext(),
+                     Nan::TypeError(errorStream.str().c_str()));
+    return;
+  }
+
+  if (info.Length() < 2 || !info[1]->IsArray()) {
+    errorStream << eCertificates;
+    resolver->Reject(Nan::GetCurrentContext(),
+                     Nan::TypeError(errorStream.str().c_str()));
+    return;
+  }
+
+  Local<Array> array = info[1].As<Array>();
+  std::vector<rtc::scoped_refptr<rtc::RTCCertificate> > certificates;
+  certificates.reserve(array->Length());
+
+  for (uint32_t i = 0; i < array->Length(); ++i) {
+    Local<Value> value = array->Get(i);
+
+    if (!HasInstance(value)) {
+      errorStream << eCertificates;
+      resolver->Reject(Nan::GetCurrentContext(),
+                       Nan::TypeError(errorStream.str().c_str()));
+      return;
+    }
+
+    certificates.push_back(
+        Nan::ObjectWrap::Unwrap<RTCCertificate>(value->ToObject())
+            ->_certificate);
+  }
+
+  String::Utf8Value path(info[0]->ToString());
+  CertificateStore::Save(*path, certificates, resolver);
+}
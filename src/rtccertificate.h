@@ -20,6 +20,7 @@
 #include <nan.h>
 #include <webrtc/api/jsep.h>
 #include <string>
+#include "addondata.h"
 
 using namespace v8;
 
@@ -32,13 +33,25 @@ class RTCCertificate : public Nan::ObjectWrap {
 
   static NAN_METHOD(ToPEM);
   static NAN_METHOD(FromPEM);
+  static NAN_METHOD(Load);
+  static NAN_METHOD(Save);
 
   static Local<Object> Create(
       const rtc::scoped_refptr<rtc::RTCCertificate>& certificate);
 
+  static bool HasInstance(Local<Value> value);
+
+  // Milliseconds since the epoch, as Expires() and HasExpired() use.
+  static uint64_t Now();
+
+  const rtc::scoped_refptr<rtc::RTCCertificate>& GetCertificate() const;
+
   static inline Nan::Persistent<v8::Function>& constructor() {
-    static Nan::Persistent<v8::Function> _constructor;
-    return _constructor;
+    return AddonData::Get()->certificateConstructor;
+  }
+
+  static inline Nan::Persistent<v8::FunctionTemplate>& functionTemplate() {
+    return AddonData::Get()->certificateTemplate;
   }
 
  private:
@@ -50,6 +63,10 @@ class RTCCertificate : public Nan::ObjectWrap {
 
  protected:
   const rtc::scoped_refptr<rtc::RTCCertificate> _certificate;
+
+  // Digests are only computed on first access, most certificates are never
+  // asked for theirs. Certificates never change, the frozen array is kept.
+  Nan::Persistent<Array> _fingerprintsArray;
 };
 
 #endif  // RTCCERTIFICATE_H_
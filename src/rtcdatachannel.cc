@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include "common.h"
+#include "observer/datachannelobserver.h"
+#include "rtcdatachannel.h"
+
+static const char sRTCDataChannel[] = "RTCDataChannel";
+
+static const char kSend[] = "send";
+static const char kClose[] = "close";
+
+static const char kLabel[] = "label";
+static const char kOrdered[] = "ordered";
+static const char kMaxPacketLifeTime[] = "maxPacketLifeTime";
+static const char kMaxRetransmits[] = "maxRetransmits";
+static const char kProtocol[] = "protocol";
+static const char kNegotiated[] = "negotiated";
+static const char kId[] = "id";
+static const char kReadyState[] = "readyState";
+static const char kBinaryType[] = "binaryType";
+static const char kBatchMessages[] = "batchMessages";
+static const char kBufferedAmount[] = "bufferedAmount";
+static const char kBufferedAmountLowThreshold[] =
+    "bufferedAmountLowThreshold";
+
+static const char kArrayBuffer[] = "arraybuffer";
+static const char kNodeBuffer[] = "nodebuffer";
+
+// Indexed by webrtc::DataChannelInterface::DataState.
+static const StringId kReadyStates[] = {
+  kStringConnecting,
+  kStringOpen,
+  kStringClosing,
+  kStringClosed,
+};
+
+static_assert(webrtc::DataChannelInterface::kClosed + 1 ==
+              sizeof(kReadyStates) / sizeof(kReadyStates[0]),
+              "kReadyStates is out of sync with DataState");
+
+static const char eIllegalConstructor[] = "Illegal constructor";
+static const char eNotOpen[] = "RTCDataChannel.readyState is not 'open'";
+static const char eSend[] = "Failed to send the data.";
+
+NAN_MODULE_INIT(RTCDataChannel::Init) {
+  Local<FunctionTemplate> ctor = Nan::New<FunctionTemplate>(New);
+  ctor->SetClassName(LOCAL_STRING(sRTCDataChannel));
+  ctor->InstanceTemplate()->SetInternalFieldCount(1);
+
+  Local<ObjectTemplate> prototype = ctor->PrototypeTemplate();
+  Nan::SetMethod(prototype, kSend, Send);
+  Nan::SetMethod(prototype, kClose, Close);
+
+  Nan::SetAccessor(prototype, LOCAL_STRING(kLabel), GetLabel);
+  Nan::SetAccessor(prototype, LOCAL_STRING(kOrdered), GetOrdered);
+  Nan::SetAccessor(prototype, LOCAL_STRING(kMaxPacketLifeTime),
+                   GetMaxPacketLifeTime);
+  Nan::SetAccessor(prototype, LOCAL_STRING(kMaxRetransmits),
+                   GetMaxRetransmits);
+  Nan::SetAccessor(prototype, LOCAL_STRING(kProtocol), GetProtocol);
+  Nan::SetAccessor(prototype, LOCAL_STRING(kNegotiated), GetNegotiated);
+  Nan::SetAccessor(prototype, LOCAL_STRING(kId), GetId);
+  Nan::SetAccessor(prototype, LOCAL_STRING(kReadyState), GetReadyState);
+  Nan::SetAccessor(prototype, LOCAL_STRING(kBufferedAmount),
+                   GetBufferedAmount);
+  Nan::SetAccessor(prototype, LOCAL_STRING(kBufferedAmountLowThreshold),
+                   GetBufferedAmountLowThreshold,
+                   SetBufferedAmountLowThreshold);
+  Nan::SetAccessor(prototype, LOCAL_STRING(kBinaryType), GetBinaryType,
+                   SetBinaryType);
+  Nan::SetAccessor(prototype, LOCAL_STRING(kBatchMessages), GetBatchMessages,
+                   SetBatchMessages);
+
+  constructor().Reset(ctor);
+  Nan::Set(target, LOCAL_STRING(sRTCDataChannel), ctor->GetFunction());
+}
+
+RTCDataChannel::RTCDataChannel(
+    const rtc::scoped_refptr<DataChannelObserver> &observer)
+    : _observer(observer),
+      _dataChannel(observer->GetDataChannel()),
+      _state(observer->GetState()),
+      _id(observer->GetId()),
+      _binaryType(kBinaryTypeArrayBuffer),
+      _bufferedAmount(0),
+      _bufferedAmountLowThreshold(0) {
+  _observer->SetTarget(this);
+}
+
+RTCDataChannel::~RTCDataChannel() {
+  _observer->SetTarget(NULL);
+  _observer->Unregister();
+  _observer = NULL;
+  _dataChannel = NULL;
+}
+
+Local<Object> RTCDataChannel::Create(
+    const rtc::scoped_refptr<DataChannelObserver> &observer) {
+  Local<Function> cons = Nan::GetFunction(Nan::New(constructor()))
+      .ToLocalChecked();
+
+  const int argc = 1;
+  Local<Value> argv[1] = { Nan::New<External>(observer.get()) };
+  return Nan::NewInstance(cons, argc, argv).ToLocalChecked();
+}
+
+NAN_METHOD(RTCDataChannel::New) {
+  CONSTRUCTOR_HEADER("RTCDataChannel");
+  ASSERT_CONSTRUCT_CALL;
+
+  // Data channels are only created by RTCPeerConnection, which passes the
+  // observer as an External.
+  if (info.Length() != 1 || !info[0]->IsExternal()) {
+    errorStream << eIllegalConstructor;
+    return Nan::ThrowTypeError(errorStream.str().c_str());
+  }
+
+  DataChannelObserver *observer = static_cast<DataChannelObserver *>(
+      info[0].As<External>()->Value());
+
+  RTCDataChannel *rtcDataChannel = new RTCDataChannel(observer);
+  rtcDataChannel->Wrap(info.This());
+
+  // Like in browsers, a channel which is not closed stays alive as long as
+  // events may be delivered to it.
+  if (rtcDataChannel->_state != webrtc::DataChannelInterface::kClosed) {
+    rtcDataChannel->Ref();
+  }
+
+  info.GetReturnValue().Set(info.This());
+}
+
+static void FreeBuffer(char *data, void *hint) {
+  delete static_cast<rtc::CopyOnWriteBuffer *>(hint);
+}
+
+Local<Value> RTCDataChannel::WrapBuffer(const rtc::CopyOnWriteBuffer &data,
+                                        BinaryType binaryType) {
+  Local<Object> buffer;
+
+  if (!data.size()) {
+    buffer = Nan::NewBuffer(0).ToLocalChecked();
+  } else {
+    // The holder shares the payload, only the const accessor may be used on
+    // it: the mutable one would clone the data since it is still referenced
+    // by the event.
+    rtc::CopyOnWriteBuffer *holder = new rtc::CopyOnWriteBuffer(data);
+    const rtc::CopyOnWriteBuffer &view = *holder;
+    buffer = Nan::NewBuffer(const_cast<char *>(view.data<char>()),
+                            view.size(), FreeBuffer, holder)
+        .ToLocalChecked();
+  }
+
+  if (binaryType == kBinaryTypeNodeBuffer) {
+    return buffer;
+  }
+
+  // The free callback is bound to the ArrayBuffer itself, not to the Buffer
+  // view, so returning the ArrayBuffer alone keeps the payload alive.
+  return buffer.As<Uint8Array>()->Buffer();
+}
+
+void RTCDataChannel::Dispatch(StringId handler, Local<Object> event) {
+  Nan::HandleScope scope;
+  Local<Value> callback = Nan::Get(handle(), StringTable::Get(handler))
+      .ToLocalChecked();
+
+  if (!callback->IsFunction()) {
+    return;
+  }
+
+  const int argc = 1;
+  Local<Value> argv[argc] = { event };
+  Nan::Call(callback.As<Function>(), handle(), argc, argv);
+}
+
+void RTCDataChannel::SetState(webrtc::DataChannelInterface::DataState state,
+                              int id) {
+  if (state == webrtc::DataChannelInterface::kClosed &&
+      _state != webrtc::DataChannelInterface::kClosed) {
+    Unref();
+  }
+
+  _state = state;
+  _id = id;
+}
+
+bool RTCDataChannel::DrainBufferedAmount(uint64_t drained) {
+  uint64_t previous = _bufferedAmount;
+  _bufferedAmount = drained < previous ? previous - drained : 0;
+
+  return previous > _bufferedAmountLowThreshold &&
+      _bufferedAmount <= _bufferedAmountLowThreshold;
+}
+
+RTCDataChannel::BinaryType RTCDataChannel::GetBinaryType() const {
+  return _binaryType;
+}
+
+NAN_METHOD(RTCDataChannel::Send) {
+  METHOD_HEADER("RTCDataChannel", "send");
+  UNWRAP_OBJECT(RTCDataChannel, object);
+
+  ASSERT_SINGLE_ARGUMENT;
+
+  if (object->_state != webrtc::DataChannelInterface::kOpen) {
+    errorStream << eNotOpen;
+    return Nan::ThrowError(errorStream.str().c_str());
+  }
+
+  // The payload is copied exactly once, straight from the JavaScript memory
+  // into the reference counted buffer which is then shared down to the SCTP
+  // transport.
+  rtc::CopyOnWriteBuffer buffer;
+  bool binary = true;
+
+  if (info[0]->IsArrayBufferView()) {
+    Local<ArrayBufferView> view = info[0].As<ArrayBufferView>();
+    buffer.SetSize(view->ByteLength());
+    view->CopyContents(buffer.data(), buffer.size());
+  } else if (info[0]->IsArrayBuffer()) {
+    ArrayBuffer::Contents contents = info[0].As<ArrayBuffer>()->GetContents();
+    buffer.SetData(static_cast<const uint8_t *>(contents.Data()),
+                   contents.ByteLength());
+  } else {
+    Local<String> text = info[0]->ToString();
+    buffer.SetSize(text->Utf8Length());
+    text->WriteUtf8(buffer.data<char>(), buffer.size(), NULL,
+                    String::NO_NULL_TERMINATION);
+    binary = false;
+  }
+
+  uint64_t queued = 0;
+
+  if (!object->_observer->Send(webrtc::DataBuffer(buffer, binary), &queued)) {
+    errorStream << eSend;
+    return Nan::ThrowError(errorStream.str().c_str());
+  }
+
+  object->_bufferedAmount += queued;
+}
+
+NAN_METHOD(RTCDataChannel::Close) {
+  UNWRAP_OBJECT(RTCDataChannel, object);
+  object->_dataChannel->Close();
+}
+
+NAN_GETTER(RTCDataChannel::GetLabel) {
+  UNWRAP_OBJECT(RTCDataChannel, object);
+  info.GetReturnValue().Set(LOCAL_STRING(object->_observer->GetLabel()));
+}
+
+NAN_GETTER(RTCDataChannel::GetOrdered) {
+  UNWRAP_OBJECT(RTCDataChannel, object);
+  info.GetReturnValue().Set(object->_observer->IsOrdered());
+}
+
+NAN_GETTER(RTCDataChannel::GetMaxPacketLifeTime) {
+  UNWRAP_OBJECT(RTCDataChannel, object);
+  int maxPacketLifeTime = object->_observer->GetMaxRetransmitTime();
+
+  if (maxPacketLifeTime < 0) {
+    info.GetReturnValue().SetNull();
+    return;
+  }
+
+  info.GetReturnValue().Set(maxPacketLifeTime);
+}
+
+NAN_GETTER(RTCDataChannel::GetMaxRetransmits) {
+  UNWRAP_OBJECT(RTCDataChannel, object);
+  int maxRetransmits = object->_observer->GetMaxRetransmits();
+
+  if (maxRetransmits < 0) {
+    info.GetReturnValue().SetNull();
+    return;
+  }
+
+  info.GetReturnValue().Set(maxRetransmits);
+}
+
+NAN_GETTER(RTCDataChannel::GetProtocol) {
+  UNWRAP_OBJECT(RTCDataChannel, object);
+  info.GetReturnValue().Set(LOCAL_STRING(object->_observer->GetProtocol()));
+}
+
+NAN_GETTER(RTCDataChannel::GetNegotiated) {
+  UNWRAP_OBJECT(RTCDataChannel, object);
+  info.GetReturnValue().Set(object->_observer->IsNegotiated());
+}
+
+NAN_GETTER(RTCDataChannel::GetId) {
+  UNWRAP_OBJECT(RTCDataChannel, object);
+
+  if (object->_id < 0) {
+    info.GetReturnValue().SetNull();
+    return;
+  }
+
+  info.GetReturnValue().Set(object->_id);
+}
+
+NAN_GETTER(RTCDataChannel::GetReadyState) {
+  UNWRAP_OBJECT(RTCDataChannel, object);
+
+  info.GetReturnValue().Set(StringTable::Get(kReadyStates, object->_state,
+                                             kStringClosed));
+}
+
+NAN_GETTER(RTCDataChannel::GetBufferedAmount) {
+  UNWRAP_OBJECT(RTCDataChannel, object);
+  info.GetReturnValue().Set(static_cast<double>(object->_bufferedAmount));
+}
+
+NAN_GETTER(RTCDataChannel::GetBufferedAmountLowThreshold) {
+  UNWRAP_OBJECT(RTCDataChannel, object);
+  info.GetReturnValue().Set(
+      static_cast<double>(object->_bufferedAmountLowThreshold));
+}
+
+NAN_SETTER(RTCDataChannel::SetBufferedAmountLowThreshold) {
+  UNWRAP_OBJECT(RTCDataChannel, object);
+  object->_bufferedAmountLowThreshold = value->Uint32Value();
+}
+
+NAN_GETTER(RTCDataChannel::GetBinaryType) {
+  UNWRAP_OBJECT(RTCDataChannel, object);
+
+  if (object->_binaryType == kBinaryTypeNodeBuffer) {
+    info.GetReturnValue().Set(StringTable::Get(kStringNodeBuffer));
+    return;
+  }
+
+  info.GetReturnValue().Set(StringTable::Get(kStringArrayBuffer));
+}
+
+NAN_SETTER(RTCDataChannel::SetBinaryType) {
+  UNWRAP_OBJECT(RTCDataChannel, object);
+
+  // Unknown values are ignored, as for any enumerated attribute.
+  String::Utf8Value binaryType(value->ToString());
+
+  if (!strcmp(*binaryType, kArrayBuffer)) {
+    object->_binaryType = kBinaryTypeArrayBuffer;
+  } else if (!strcmp(*binaryType, kNodeBuffer)) {
+    object->_binaryType = kBinaryTypeNodeBuffer;
+  }
+}
+
+NAN_GETTER(RTCDataChannel::GetBatchMessages) {
+  UNWRAP_OBJECT(RTCDataChannel, object);
+  info.GetReturnValue().Set(object->_observer->GetBatchMessages());
+}
+
+NAN_SETTER(RTCDataChannel::SetBatchMessages) {
+  UNWRAP_OBJECT(RTCDataChannel, object);
+  object->_observer->SetBatchMessages(value->BooleanValue());
+}
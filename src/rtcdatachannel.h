@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RTCDATACHANNEL_H_
+#define RTCDATACHANNEL_H_
+
+#include <nan.h>
+#include <webrtc/api/datachannelinterface.h>
+#include <webrtc/base/copyonwritebuffer.h>
+#include "addondata.h"
+#include "stringtable.h"
+
+using namespace v8;
+
+class DataChannelObserver;
+class RTCDataChannel : public Nan::ObjectWrap {
+ public:
+  enum BinaryType {
+    kBinaryTypeArrayBuffer,
+    kBinaryTypeNodeBuffer,
+  };
+
+  static NAN_MODULE_INIT(Init);
+
+  // Wraps a data channel whose observer has already been registered, the
+  // wrapper takes over the observer registration.
+  static Local<Object> Create(
+      const rtc::scoped_refptr<DataChannelObserver> &observer);
+
+  // Exposes a received payload to JavaScript without copying it: the
+  // returned Buffer, or its ArrayBuffer, keeps a reference on the payload
+  // until it is garbage collected.
+  static Local<Value> WrapBuffer(const rtc::CopyOnWriteBuffer &data,
+                                 BinaryType binaryType);
+
+  void Dispatch(StringId handler, Local<Object> event);
+  void SetState(webrtc::DataChannelInterface::DataState state, int id);
+
+  // Returns true when bufferedAmount fell from above
+  // bufferedAmountLowThreshold to at most that value.
+  bool DrainBufferedAmount(uint64_t drained);
+
+  BinaryType GetBinaryType() const;
+
+ private:
+  explicit RTCDataChannel(
+      const rtc::scoped_refptr<DataChannelObserver> &observer);
+  ~RTCDataChannel();
+
+  static NAN_METHOD(New);
+  static NAN_METHOD(Send);
+  static NAN_METHOD(Close);
+
+  static NAN_GETTER(GetLabel);
+  static NAN_GETTER(GetOrdered);
+  static NAN_GETTER(GetMaxPacketLifeTime);
+  static NAN_GETTER(GetMaxRetransmits);
+  static NAN_GETTER(GetProtocol);
+  static NAN_GETTER(GetNegotiated);
+  static NAN_GETTER(GetId);
+  static NAN_GETTER(GetReadyState);
+  static NAN_GETTER(GetBufferedAmount);
+  static NAN_GETTER(GetBufferedAmountLowThreshold);
+  static NAN_SETTER(SetBufferedAmountLowThreshold);
+  static NAN_GETTER(GetBinaryType);
+  static NAN_SETTER(SetBinaryType);
+  static NAN_GETTER(GetBatchMessages);
+  static NAN_SETTER(SetBatchMessages);
+
+  static inline Nan::Persistent<FunctionTemplate>& constructor() {
+    return AddonData::Get()->dataChannelTemplate;
+  }
+
+ protected:
+  rtc::scoped_refptr<DataChannelObserver> _observer;
+  rtc::scoped_refptr<webrtc::DataChannelInterface> _dataChannel;
+
+  webrtc::DataChannelInterface::DataState _state;
+  int _id;
+  BinaryType _binaryType;
+
+  // Bytes queued by send() and not yet handed to the transport.
+  uint64_t _bufferedAmount;
+  uint64_t _bufferedAmountLowThreshold;
+};
+
+#endif  // RTCDATACHANNEL_H_
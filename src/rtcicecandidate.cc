@@ -14,17 +14,14 @@
  * limitations under the License.
  */
 
-#include <cstring>
 #include <memory>
 #include <iostream>
-#include <webrtc/p2p/base/candidate.h>
-#include <webrtc/p2p/base/port.h>
+#include <vector>
 
+#include "candidateparser.h"
 #include "common.h"
 #include "rtcicecandidate.h"
 
-Nan::Persistent<FunctionTemplate> RTCIceCandidate::constructor;
-
 static const char sRTCIceCandidate[] = "RTCIceCandidate";
 
 static const char kCandidate[] = "candidate";
@@ -39,11 +36,23 @@ static const char kType[] = "type";
 static const char kTcpType[] = "tcpType";
 static const char kRelatedAddress[] = "relatedAddress";
 static const char kRelatedPort[] = "relatedPort";
+static const char kParseMany[] = "parseMany";
 
 static const char eBothAreNull[] =
     "Both 'sdpMid' and 'sdpMLineIndex' properties are null.";
-static const char eSerialize[] =
-    "Failed to serialize ICE candidate.";
+static const char eCandidates[] =
+    "The 'candidates' argument is not an array of RTCIceCandidateInit.";
+
+// Copies a string straight into 'out', without the intermediate buffer of
+// String::Utf8Value.
+static void CopyString(Local<String> value, std::string *out) {
+  out->resize(value->Utf8Length());
+
+  if (!out->empty()) {
+    value->WriteUtf8(&(*out)[0], out->size(), NULL,
+                     String::NO_NULL_TERMINATION);
+  }
+}
 
 NAN_MODULE_INIT(RTCIceCandidate::Init) {
   Local<FunctionTemplate> ctor = Nan::New<FunctionTemplate>(New);
@@ -57,7 +66,7 @@ NAN_MODULE_INIT(RTCIceCandidate::Init) {
   Nan::SetAccessor(instance, LOCAL_STRING(kSdpMLineIndex), GetSdpMLineIndex);
 
   Local<ObjectTemplate> prototype = ctor->PrototypeTemplate();
-  Nan::SetAccessor(prototype, LOCAL_STRING(kFoundation), GetCandidate);
+  Nan::SetAccessor(prototype, LOCAL_STRING(kFoundation), GetFoundation);
   Nan::SetAccessor(prototype, LOCAL_STRING(kPriority), GetPriority);
   Nan::SetAccessor(prototype, LOCAL_STRING(kIp), GetIp);
   Nan::SetAccessor(prototype, LOCAL_STRING(kProtocol), GetProtocol);
@@ -67,17 +76,29 @@ NAN_MODULE_INIT(RTCIceCandidate::Init) {
   Nan::SetAccessor(prototype, LOCAL_STRING(kRelatedAddress), GetRelatedAddress);
   Nan::SetAccessor(prototype, LOCAL_STRING(kRelatedPort), GetRelatedPort);
 
-  constructor.Reset(ctor);
+  Nan::SetMethod(ctor, kParseMany, ParseMany);
+
+  constructor().Reset(ctor);
   Nan::Set(target, LOCAL_STRING(sRTCIceCandidate),
            ctor->GetFunction());
 }
 
-RTCIceCandidate::RTCIceCandidate(webrtc::IceCandidateInterface *iceCandidate)
-    : _iceCandidate(iceCandidate) {
+RTCIceCandidate::RTCIceCandidate(const CandidateInfo &candidate)
+    : _candidate(candidate) {
 }
 
 RTCIceCandidate::~RTCIceCandidate() {
-  delete _iceCandidate;
+}
+
+Local<Object> RTCIceCandidate::Create(const CandidateInfo &candidate) {
+  Local<Function> cons = Nan::GetFunction(Nan::New(constructor()))
+      .ToLocalChecked();
+
+  const int argc = 1;
+  Local<Value> argv[1] = {
+    Nan::New<External>(const_cast<CandidateInfo *>(&candidate))
+  };
+  return Nan::NewInstance(cons, argc, argv).ToLocalChecked();
 }
 
 NAN_METHOD(RTCIceCandidate::New) {
@@ -85,6 +106,17 @@ NAN_METHOD(RTCIceCandidate::New) {
 
   ASSERT_CONSTRUCT_CALL;
 
+  // Candidates decoded natively are passed as an External by Create().
+  if (info.Length() == 1 && info[0]->IsExternal()) {
+    const CandidateInfo *candidate =
+        static_cast<CandidateInfo *>(info[0].As<External>()->Value());
+
+    RTCIceCandidate *rtcIceCandidate = new RTCIceCandidate(*candidate);
+    rtcIceCandidate->Wrap(info.This());
+    info.GetReturnValue().Set(info.This());
+    return;
+  }
+
   ASSERT_SINGLE_ARGUMENT;
   ASSERT_OBJECT_ARGUMENT(0, candidateInitDict);
   ASSERT_OBJECT_PROPERTY(candidateInitDict, kCandidate, candidateVal);
@@ -107,127 +139,167 @@ NAN_METHOD(RTCIceCandidate::New) {
   String::Utf8Value sdpMid(sdpMidVal->ToString());
   int32_t sdpMLineIndex = sdpMLineIndexVal->Int32Value();
 
-  webrtc::SdpParseError error;
-  webrtc::IceCandidateInterface *iceCandidate;
-  iceCandidate = webrtc::CreateIceCandidate(
-      IS_STRICTLY_NULL(sdpMidVal) ? "" : *sdpMid, sdpMLineIndex, *cand, &error);
+  CandidateInfo candidate;
+  std::string error;
 
-  if (!iceCandidate) {
-    errorStream << error.description;
+  if (!ParseCandidate(IS_STRICTLY_NULL(sdpMidVal) ? "" : *sdpMid,
+                      sdpMLineIndex, *cand, &candidate, &error)) {
+    errorStream << error;
     return Nan::ThrowError(errorStream.str().c_str());
   }
 
-  RTCIceCandidate *rtcIceCandidate = new RTCIceCandidate(iceCandidate);
+  RTCIceCandidate *rtcIceCandidate = new RTCIceCandidate(candidate);
   rtcIceCandidate->Wrap(info.This());
   info.GetReturnValue().Set(info.This());
 }
 
-NAN_GETTER(RTCIceCandidate::GetCandidate) {
-  UNWRAP_OBJECT(RTCIceCandidate, object);
-  std::string candidate;
+NAN_METHOD(RTCIceCandidate::ParseMany) {
+  METHOD_HEADER("RTCIceCandidate", "parseMany");
+  DECLARE_PROMISE_RESOLVER;
+
+  // Non-standard: parses many candidates at once off the main thread.
+  if (info.Length() < 1 || !info[0]->IsArray()) {
+    errorStream << eCandidates;
+    resolver->Reject(Nan::GetCurrentContext(),
+                     Nan::TypeError(errorStream.str().c_str()));
+    return;
+  }
+
+  Local<Array> array = info[0].As<Array>();
+  std::vector<CandidateInit> candidates(array->Length());
+
+  for (uint32_t i = 0; i < array->Length(); ++i) {
+    Local<Value> value = array->Get(i);
+
+    if (!value->IsObject()) {
+      errorStream << eCandidates;
+      resolver->Reject(Nan::GetCurrentContext(),
+                       Nan::TypeError(errorStream.str().c_str()));
+      return;
+    }
+
+    Local<Object> candidateInitDict = value->ToObject();
+    ASSERT_REJECT_OBJECT_PROPERTY(candidateInitDict, kCandidate, candidateVal);
+
+    if (!candidateVal->IsString()) {
+      errorStream << ERROR_PROPERTY_NOT_STRING(kCandidate);
+      resolver->Reject(Nan::GetCurrentContext(),
+                       Nan::TypeError(errorStream.str().c_str()));
+      return;
+    }
+
+    DECLARE_OBJECT_PROPERTY(candidateInitDict, kSdpMid, sdpMidVal);
+    DECLARE_OBJECT_PROPERTY(candidateInitDict, kSdpMLineIndex,
+                            sdpMLineIndexVal);
 
-  if (!object->_iceCandidate->ToString(&candidate)) {
-    return Nan::ThrowError(eSerialize);
+    if (IS_STRICTLY_NULL(sdpMidVal) && IS_STRICTLY_NULL(sdpMLineIndexVal)) {
+      errorStream << eBothAreNull;
+      resolver->Reject(Nan::GetCurrentContext(),
+                       Nan::Error(errorStream.str().c_str()));
+      return;
+    }
+
+    CandidateInit &init = candidates[i];
+    CopyString(candidateVal.As<String>(), &init.candidate);
+
+    if (!IS_STRICTLY_NULL(sdpMidVal)) {
+      CopyString(sdpMidVal->ToString(), &init.sdpMid);
+    }
+
+    init.sdpMLineIndex = sdpMLineIndexVal->Int32Value();
   }
 
-  info.GetReturnValue().Set(LOCAL_STRING(candidate));
+  CandidateParser::ParseMany(&candidates, resolver);
+}
+
+NAN_GETTER(RTCIceCandidate::GetCandidate) {
+  UNWRAP_OBJECT(RTCIceCandidate, object);
+
+  info.GetReturnValue().Set(LOCAL_STRING(object->_candidate.candidate));
 }
 
 NAN_GETTER(RTCIceCandidate::GetSdpMid) {
   UNWRAP_OBJECT(RTCIceCandidate, object);
 
-  if (!object->_iceCandidate->sdp_mid().length()) {
+  if (object->_candidate.sdpMid.empty()) {
     info.GetReturnValue().SetNull();
     return;
   }
 
-  info.GetReturnValue().Set(LOCAL_STRING(object->_iceCandidate->sdp_mid()));
+  info.GetReturnValue().Set(LOCAL_STRING(object->_candidate.sdpMid));
 }
 
 NAN_GETTER(RTCIceCandidate::GetSdpMLineIndex) {
   UNWRAP_OBJECT(RTCIceCandidate, object);
 
-  info.GetReturnValue().Set(object->_iceCandidate->sdp_mline_index());
+  info.GetReturnValue().Set(object->_candidate.sdpMLineIndex);
 }
 
 NAN_GETTER(RTCIceCandidate::GetFoundation) {
   UNWRAP_OBJECT(RTCIceCandidate, object);
-  const cricket::Candidate &cand = object->_iceCandidate->candidate();
 
-  info.GetReturnValue().Set(LOCAL_STRING(cand.foundation()));
+  info.GetReturnValue().Set(LOCAL_STRING(object->_candidate.foundation));
 }
 
 NAN_GETTER(RTCIceCandidate::GetPriority) {
   UNWRAP_OBJECT(RTCIceCandidate, object);
-  const cricket::Candidate &cand = object->_iceCandidate->candidate();
 
-  info.GetReturnValue().Set(cand.priority());
+  info.GetReturnValue().Set(object->_candidate.priority);
 }
 
 NAN_GETTER(RTCIceCandidate::GetIp) {
   UNWRAP_OBJECT(RTCIceCandidate, object);
-  const cricket::Candidate &cand = object->_iceCandidate->candidate();
 
-  info.GetReturnValue().Set(LOCAL_STRING(cand.address().ipaddr().ToString()));
+  info.GetReturnValue().Set(LOCAL_STRING(object->_candidate.ip));
 }
 
 NAN_GETTER(RTCIceCandidate::GetProtocol) {
   UNWRAP_OBJECT(RTCIceCandidate, object);
-  const cricket::Candidate &cand = object->_iceCandidate->candidate();
 
-  info.GetReturnValue().Set(LOCAL_STRING(cand.protocol()));
+  info.GetReturnValue().Set(LOCAL_STRING(object->_candidate.protocol));
 }
 
 NAN_GETTER(RTCIceCandidate::GetPort) {
   UNWRAP_OBJECT(RTCIceCandidate, object);
-  const cricket::Candidate &cand = object->_iceCandidate->candidate();
 
-  info.GetReturnValue().Set(cand.address().port());
+  info.GetReturnValue().Set(object->_candidate.port);
 }
 
 NAN_GETTER(RTCIceCandidate::GetType) {
   UNWRAP_OBJECT(RTCIceCandidate, object);
-  const cricket::Candidate &cand = object->_iceCandidate->candidate();
 
-  info.GetReturnValue().Set(LOCAL_STRING(cand.type()));
+  info.GetReturnValue().Set(LOCAL_STRING(object->_candidate.type));
 }
 
 NAN_GETTER(RTCIceCandidate::GetTcpType) {
   UNWRAP_OBJECT(RTCIceCandidate, object);
-  const cricket::Candidate &cand = object->_iceCandidate->candidate();
-  const std::string &tcptype = cand.tcptype();
 
-  if (!tcptype.length()) {
+  if (object->_candidate.tcpType.empty()) {
     info.GetReturnValue().SetNull();
     return;
   }
 
-  info.GetReturnValue().Set(LOCAL_STRING(tcptype));
+  info.GetReturnValue().Set(LOCAL_STRING(object->_candidate.tcpType));
 }
 
 NAN_GETTER(RTCIceCandidate::GetRelatedAddress) {
   UNWRAP_OBJECT(RTCIceCandidate, object);
-  const cricket::Candidate &cand = object->_iceCandidate->candidate();
 
-  if (!strcmp(cricket::LOCAL_PORT_TYPE, cand.type().c_str()) ||
-      cand.related_address().IsNil()) {
+  if (!object->_candidate.hasRelatedAddress) {
     info.GetReturnValue().SetNull();
     return;
   }
 
-  info.GetReturnValue().Set(
-      LOCAL_STRING(cand.related_address().ipaddr().ToString()));
+  info.GetReturnValue().Set(LOCAL_STRING(object->_candidate.relatedAddress));
 }
 
 NAN_GETTER(RTCIceCandidate::GetRelatedPort) {
   UNWRAP_OBJECT(RTCIceCandidate, object);
-  const cricket::Candidate &cand = object->_iceCandidate->candidate();
 
-  if (!strcmp(cricket::LOCAL_PORT_TYPE, cand.type().c_str()) ||
-      cand.related_address().IsNil()) {
+  if (!object->_candidate.hasRelatedAddress) {
     info.GetReturnValue().SetNull();
     return;
   }
 
-  info.GetReturnValue().Set(cand.related_address().port());
+  info.GetReturnValue().Set(object->_candidate.relatedPort);
 }
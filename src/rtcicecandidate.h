@@ -19,6 +19,9 @@
 
 #include <nan.h>
 #include <webrtc/api/jsep.h>
+#include <string>
+#include "addondata.h"
+#include "candidateinfo.h"
 
 using namespace v8;
 
@@ -26,11 +29,14 @@ class RTCIceCandidate : public Nan::ObjectWrap {
  public:
   static NAN_MODULE_INIT(Init);
 
+  static Local<Object> Create(const CandidateInfo &candidate);
+
  private:
-  explicit RTCIceCandidate(webrtc::IceCandidateInterface *iceCandidate);
+  explicit RTCIceCandidate(const CandidateInfo &candidate);
   ~RTCIceCandidate();
 
   static NAN_METHOD(New);
+  static NAN_METHOD(ParseMany);
 
   static NAN_GETTER(GetCandidate);
   static NAN_GETTER(GetSdpMid);
@@ -46,10 +52,12 @@ class RTCIceCandidate : public Nan::ObjectWrap {
   static NAN_GETTER(GetRelatedAddress);
   static NAN_GETTER(GetRelatedPort);
 
-  static Nan::Persistent<FunctionTemplate> constructor;
+  static inline Nan::Persistent<FunctionTemplate>& constructor() {
+    return AddonData::Get()->iceCandidateTemplate;
+  }
 
  protected:
-  webrtc::IceCandidateInterface *_iceCandidate;
+  const CandidateInfo _candidate;
 };
 
 #endif  // RTCICECANDIDATE_H_
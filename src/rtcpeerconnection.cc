@@ -14,23 +14,41 @@
  * limitations under the License.
  */
 
+#include <cmath>
 #include <cstring>
 #include <memory>
 #include <iostream>
 #include <webrtc/api/test/fakeconstraints.h>
+#include "certificategenerator.h"
+#include "certificatepool.h"
 #include "common.h"
+#include "event/getstatsevent.h"
 #include "globals.h"
 #include "observer/createsessiondescriptionobserver.h"
+#include "observer/datachannelobserver.h"
 #include "observer/peerconnectionobserver.h"
+#include "observer/rtcstatscollectorobserver.h"
+#include "observer/setsessiondescriptionobserver.h"
+#include "operationschain.h"
 #include "rtccertificate.h"
+#include "rtcdatachannel.h"
 #include "rtcpeerconnection.h"
-
-Nan::Persistent<FunctionTemplate> RTCPeerConnection::constructor;
+#include "rtcsessiondescription.h"
+#include "stats.h"
+#include "statssampler.h"
 
 static const char sRTCPeerConnection[] = "RTCPeerConnection";
 
+static const char kCreateDataChannel[] = "createDataChannel";
+static const char kCreateAnswer[] = "createAnswer";
 static const char kCreateOffer[] = "createOffer";
 static const char kGenerateCertificate[] = "generateCertificate";
+static const char kGetStats[] = "getStats";
+static const char kGetStatsHistory[] = "getStatsHistory";
+static const char kSetLocalDescription[] = "setLocalDescription";
+static const char kSetRemoteDescription[] = "setRemoteDescription";
+static const char kSetStatsAlert[] = "setStatsAlert";
+static const char kStatsSchema[] = "statsSchema";
 
 static const char kName[] = "name";
 static const char kRSA[] = "RSASSA-PKCS1-v1_5";
@@ -51,23 +69,59 @@ static const char kPendingLocalDescription[] = "pendingLocalDescription";
 static const char kPendingRemoteDescription[] = "pendingRemoteDescription";
 static const char kSignalingState[] = "signalingState";
 
-static const char kNew[] = "new";
-static const char kChecking[] = "checking";
-static const char kConnected[] = "connected";
-static const char kCompleted[] = "completed";
-static const char kFailed[] = "failed";
-static const char kDisconnected[] = "disconnected";
-static const char kClosed[] = "closed";
-static const char kUnknown[] = "unknown";
-
-static const char kStable[] = "stable";
-static const char kHaveLocalOffer[] = "have-local-offer";
-static const char kHaveLocalPranswer[] = "have-local-pranswer";
-static const char kHaveRemoteOffer[] = "have-remote-offer";
-static const char kHaveRemotePranswer[] = "have-remote-pranswer";
+// Indexed by webrtc::PeerConnectionInterface::IceConnectionState.
+static const StringId kIceConnectionStates[] = {
+  kStringNew,
+  kStringChecking,
+  kStringConnected,
+  kStringCompleted,
+  kStringFailed,
+  kStringDisconnected,
+  kStringClosed,
+};
+
+static_assert(webrtc::PeerConnectionInterface::kIceConnectionClosed + 1 ==
+              sizeof(kIceConnectionStates) / sizeof(kIceConnectionStates[0]),
+              "kIceConnectionStates is out of sync with IceConnectionState");
+
+// Indexed by webrtc::PeerConnectionInterface::IceGatheringState.
+static const StringId kIceGatheringStates[] = {
+  kStringNew,
+  kStringGathering,
+  kStringComplete,
+};
+
+static_assert(webrtc::PeerConnectionInterface::kIceGatheringComplete + 1 ==
+              sizeof(kIceGatheringStates) / sizeof(kIceGatheringStates[0]),
+              "kIceGatheringStates is out of sync with IceGatheringState");
+
+// Indexed by webrtc::PeerConnectionInterface::SignalingState, 'closed' is
+// reported as unknown.
+static const StringId kSignalingStates[] = {
+  kStringStable,
+  kStringHaveLocalOffer,
+  kStringHaveLocalPranswer,
+  kStringHaveRemoteOffer,
+  kStringHaveRemotePranswer,
+};
+
+static_assert(webrtc::PeerConnectionInterface::kHaveRemotePrAnswer + 1 ==
+              sizeof(kSignalingStates) / sizeof(kSignalingStates[0]),
+              "kSignalingStates is out of sync with SignalingState");
 
 static const char kIceRestart[] = "iceRestart";
 
+static const char kOrdered[] = "ordered";
+static const char kMaxPacketLifeTime[] = "maxPacketLifeTime";
+static const char kMaxRetransmits[] = "maxRetransmits";
+static const char kProtocol[] = "protocol";
+static const char kNegotiated[] = "negotiated";
+static const char kId[] = "id";
+static const char kFactory[] = "factory";
+static const char kIceCandidateBatchWindow[] = "iceCandidateBatchWindow";
+static const char kThreadGroup[] = "threadGroup";
+static const char kCertificates[] = "certificates";
+
 static const char eCurve[] = "EcKeyGenParams: Unrecognized namedCurve";
 static const char eHash[] = "Algorithm: Unrecognized hash";
 static const char eName[] = "Algorithm: Unrecognized name";
@@ -75,7 +129,36 @@ static const char eUnsupported[] = "The 1st argument provided is an "
     "AlgorithmIdentifier with a supported algorithm name, but the parameters "
     "are not supported.";
 
-static const char eFailure[] = "Failed to generate the certificate.";
+static const char eThreads[] = "Failed to start the WebRTC threads.";
+static const char eFactory[] = "The 'factory' property is out of range.";
+static const char eThreadGroup[] =
+    "The 'threadGroup' property is out of range.";
+static const char eIceCandidateBatchWindow[] =
+    "The 'iceCandidateBatchWindow' property is out of range.";
+static const char eCertificates[] =
+    "The 'certificates' property is not an array of RTCCertificate.";
+static const char eCertificateExpired[] =
+    "One of the certificates has expired.";
+
+static const char eBothRetransmits[] = "The 'maxPacketLifeTime' and "
+    "'maxRetransmits' properties cannot both be set.";
+static const char eNegotiatedId[] =
+    "The 'id' property is required when 'negotiated' is true.";
+static const char eCreateDataChannel[] = "Failed to create the data channel.";
+static const char eStatsArray[] =
+    "parameter 1 ('array') is not a Float64Array or a BigUint64Array.";
+static const char eStatsOffset[] =
+    "parameter 2 ('offset') is not an integer.";
+static const char eStatsRange[] =
+    "The array is too small to hold the stats at the given offset.";
+static const char eStatsSampler[] =
+    "The stats sampler is disabled, see configure({ stats: { period } }).";
+static const char eStatsThreshold[] =
+    "parameter 2 ('threshold') is not a number or null.";
+
+static const uint32_t kMaxIceCandidateBatchWindow = 10000;
+static const int kMaxDataChannelId = 65534;
+static const int kMaxUnsignedShort = 65535;
 
 NAN_MODULE_INIT(RTCPeerConnection::Init) {
   Local<FunctionTemplate> ctor = Nan::New<FunctionTemplate>(New);
@@ -85,7 +168,14 @@ NAN_MODULE_INIT(RTCPeerConnection::Init) {
   Nan::SetMethod(ctor, kGenerateCertificate, GenerateCertificate);
 
   Local<ObjectTemplate> prototype = ctor->InstanceTemplate();
+  Nan::SetMethod(prototype, kCreateDataChannel, CreateDataChannel);
   Nan::SetMethod(prototype, kCreateOffer, CreateOffer);
+  Nan::SetMethod(prototype, kCreateAnswer, CreateAnswer);
+  Nan::SetMethod(prototype, kSetLocalDescription, SetLocalDescription);
+  Nan::SetMethod(prototype, kSetRemoteDescription, SetRemoteDescription);
+  Nan::SetMethod(prototype, kGetStats, GetStats);
+  Nan::SetMethod(prototype, kGetStatsHistory, GetStatsHistory);
+  Nan::SetMethod(prototype, kSetStatsAlert, SetStatsAlert);
 
   Local<ObjectTemplate> tpl = ctor->InstanceTemplate();
   Nan::SetAccessor(tpl, LOCAL_STRING(kConnectionState),
@@ -105,33 +195,204 @@ NAN_MODULE_INIT(RTCPeerConnection::Init) {
   Nan::SetAccessor(tpl, LOCAL_STRING(kSignalingState),
                    GetSignalingState);
 
-  constructor.Reset(ctor);
-  Nan::Set(target, LOCAL_STRING(sRTCPeerConnection), ctor->GetFunction());
+  Local<Function> cons = ctor->GetFunction();
+  Local<Array> statsSchema = Nan::New<Array>(kStatsFieldCount);
+
+  for (uint32_t i = 0; i < kStatsFieldCount; i++) {
+    Nan::Set(statsSchema, i, LOCAL_STRING(
+        GetStatsFieldName(static_cast<StatsField>(i))));
+  }
+
+  Nan::Set(cons, LOCAL_STRING(kStatsSchema), statsSchema);
+
+  constructor().Reset(ctor);
+  Nan::Set(target, LOCAL_STRING(sRTCPeerConnection), cons);
 }
 
 RTCPeerConnection::RTCPeerConnection(
+    ThreadGroup *threadGroup,
+    const rtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface>&
+        peerConnectionFactory,
     const webrtc::PeerConnectionInterface::RTCConfiguration& config,
-    const webrtc::MediaConstraintsInterface& constraints) {
-
-  _peerConnectionFactory = webrtc::CreatePeerConnectionFactory(
-      Globals::GetSignalingThread(), Globals::GetWorkerThread(),
-      NULL, NULL, NULL);
+    const webrtc::MediaConstraintsInterface& constraints,
+    uint32_t iceCandidateBatchWindow)
+    : _threadGroup(threadGroup),
+      _peerConnectionFactory(peerConnectionFactory),
+      _signalingState(webrtc::PeerConnectionInterface::kStable),
+      _iceGatheringState(webrtc::PeerConnectionInterface::kIceGatheringNew),
+      _iceConnectionState(
+          webrtc::PeerConnectionInterface::kIceConnectionNew),
+      _countedInThreadGroup(true) {
+  _threadGroup->AddConnection();
+  AddonData::Get()->AddConnection(this);
 
   _peerConnectionObserver = PeerConnectionObserver::Create();
+  _peerConnectionObserver->SetTarget(this);
+
+  if (iceCandidateBatchWindow) {
+    _peerConnectionObserver->SetIceCandidateBatchWindow(
+        _threadGroup->GetSignalingThread(), iceCandidateBatchWindow);
+  }
+
   _peerConnection = _peerConnectionFactory->CreatePeerConnection(
           config, &constraints, NULL, NULL, _peerConnectionObserver);
   _peerConnectionObserver->SetPeerConnection(_peerConnection);
+  _operationsChain = OperationsChain::Create(
+      _threadGroup->GetSignalingThread(), _peerConnection);
+
+  StatsSampler *statsSampler = _threadGroup->GetStatsSampler();
+
+  if (statsSampler && _peerConnection.get()) {
+    _statsHistory = StatsHistory::Create(Globals::GetOptions().stats,
+                                         _peerConnection,
+                                         _peerConnectionObserver);
+    statsSampler->Add(_statsHistory);
+  }
 }
 
 RTCPeerConnection::~RTCPeerConnection() {
+  Teardown();
+}
+
+void RTCPeerConnection::Teardown() {
+  if (!_peerConnectionObserver.get()) {
+    return;
+  }
+
+  AddonData *addonData = AddonData::Get();
+
+  if (addonData) {
+    addonData->RemoveConnection(this);
+  }
+
+  if (_statsHistory.get()) {
+    _threadGroup->GetStatsSampler()->Remove(_statsHistory);
+    _statsHistory = NULL;
+  }
+
+  _peerConnectionObserver->SetTarget(NULL);
+  _operationsChain->Close();
+  _operationsChain = NULL;
   _peerConnection = NULL;
   _peerConnectionObserver = NULL;
   _peerConnectionFactory = NULL;
+
+  LeaveThreadGroup();
+}
+
+void RTCPeerConnection::LeaveThreadGroup() {
+  if (_countedInThreadGroup) {
+    _countedInThreadGroup = false;
+    _threadGroup->RemoveConnection();
+  }
 }
 
 NAN_METHOD(RTCPeerConnection::New) {
+  CONSTRUCTOR_HEADER("RTCPeerConnection");
+
+  if (!Globals::Start()) {
+    errorStream << eThreads;
+    return Nan::ThrowError(errorStream.str().c_str());
+  }
+
+  // Non-standard: 'threadGroup' pins the connection to a thread group instead
+  // of letting the placement policy choose, and 'factory' selects which
+  // pooled PeerConnectionFactory of that group backs it. Connections sharing
+  // a factory share its media engine. 'iceCandidateBatchWindow' collects ICE
+  // candidates for that many milliseconds and delivers them together through
+  // onicecandidates instead of onicecandidate.
+  ThreadGroup *threadGroup = NULL;
+  uint32_t factoryIndex = 0;
+  uint32_t iceCandidateBatchWindow = 0;
   webrtc::FakeConstraints constraints;
   webrtc::PeerConnectionInterface::RTCConfiguration config;
+
+  if (info.Length() > 0 && info[0]->IsObject()) {
+    Local<Object> configuration = info[0]->ToObject();
+
+    if (HAS_OWN_PROPERTY(configuration, kThreadGroup)) {
+      DECLARE_OBJECT_PROPERTY(configuration, kThreadGroup, threadGroupVal);
+      ASSERT_PROPERTY_INTEGER(kThreadGroup, threadGroupVal, threadGroupId);
+
+      if (threadGroupId->Value() < 0 ||
+          threadGroupId->Value() >= Globals::GetThreadGroupCount()) {
+        errorStream << eThreadGroup;
+        return Nan::ThrowRangeError(errorStream.str().c_str());
+      }
+
+      threadGroup = Globals::GetThreadGroup(threadGroupId->Uint32Value());
+    }
+
+    if (HAS_OWN_PROPERTY(configuration, kFactory)) {
+      DECLARE_OBJECT_PROPERTY(configuration, kFactory, factoryVal);
+      ASSERT_PROPERTY_INTEGER(kFactory, factoryVal, factory);
+
+      if (factory->Value() < 0 ||
+          factory->Value() >= ThreadGroup::kMaxPeerConnectionFactories) {
+        errorStream << eFactory;
+        return Nan::ThrowRangeError(errorStream.str().c_str());
+      }
+
+      factoryIndex = factory->Uint32Value();
+    }
+
+    if (HAS_OWN_PROPERTY(configuration, kIceCandidateBatchWindow)) {
+      DECLARE_OBJECT_PROPERTY(configuration, kIceCandidateBatchWindow,
+                              windowVal);
+      ASSERT_PROPERTY_INTEGER(kIceCandidateBatchWindow, windowVal, window);
+
+      if (window->Value() < 0 ||
+          window->Value() > kMaxIceCandidateBatchWindow) {
+        errorStream << eIceCandidateBatchWindow;
+        return Nan::ThrowRangeError(errorStream.str().c_str());
+      }
+
+      iceCandidateBatchWindow = window->Uint32Value();
+    }
+
+    // Connections given the same certificates share their DTLS identity
+    // instead of generating one each.
+    if (HAS_OWN_PROPERTY(configuration, kCertificates)) {
+      DECLARE_OBJECT_PROPERTY(configuration, kCertificates, certificatesVal);
+
+      if (!certificatesVal->IsArray()) {
+        errorStream << eCertificates;
+        return Nan::ThrowTypeError(errorStream.str().c_str());
+      }
+
+      Local<Array> certificates = certificatesVal.As<Array>();
+      uint64_t now = RTCCertificate::Now();
+
+      for (uint32_t i = 0; i < certificates->Length(); ++i) {
+        Local<Value> certificateVal = certificates->Get(i);
+
+        if (!RTCCertificate::HasInstance(certificateVal)) {
+          errorStream << eCertificates;
+          return Nan::ThrowTypeError(errorStream.str().c_str());
+        }
+
+        RTCCertificate *certificate = Nan::ObjectWrap::Unwrap<RTCCertificate>(
+            certificateVal->ToObject());
+
+        if (certificate->GetCertificate()->HasExpired(now)) {
+          errorStream << eCertificateExpired;
+          return Nan::ThrowError(errorStream.str().c_str());
+        }
+
+        config.certificates.push_back(certificate->GetCertificate());
+      }
+    }
+  }
+
+  if (!threadGroup) {
+    threadGroup = Globals::SelectThreadGroup();
+
+    if (!threadGroup) {
+      errorStream << eThreads;
+      return Nan::ThrowError(errorStream.str().c_str());
+    }
+  }
+
   webrtc::PeerConnectionInterface::IceServer server;
   server.uri = "stun:stun.l.google.com:19302";
   config.servers.push_back(server);
@@ -139,20 +400,130 @@ NAN_METHOD(RTCPeerConnection::New) {
   constraints.AddOptional(webrtc::MediaConstraintsInterface::kEnableDtlsSrtp,
                           "true");
 
-  RTCPeerConnection *rtcPeerConnection = new RTCPeerConnection(config,
-                                                               constraints);
+  // A pooled certificate spares the connection its own key generation.
+  CertificatePool *certificatePool = Globals::GetCertificatePool();
+
+  if (certificatePool && config.certificates.empty()) {
+    rtc::scoped_refptr<rtc::RTCCertificate> certificate =
+        certificatePool->Take(CertificatePool::kECDSA);
+
+    if (certificate.get()) {
+      config.certificates.push_back(certificate);
+    }
+  }
+
+  RTCPeerConnection *rtcPeerConnection = new RTCPeerConnection(
+      threadGroup, threadGroup->GetPeerConnectionFactory(factoryIndex),
+      config, constraints, iceCandidateBatchWindow);
   rtcPeerConnection->Wrap(info.This());
 
   info.GetReturnValue().Set(info.This());
 }
 
+NAN_METHOD(RTCPeerConnection::CreateDataChannel) {
+  METHOD_HEADER("RTCPeerConnection", "createDataChannel");
+  UNWRAP_OBJECT(RTCPeerConnection, object);
+
+  ASSERT_SINGLE_ARGUMENT;
+  String::Utf8Value label(info[0]->ToString());
+
+  webrtc::DataChannelInit init;
+
+  if (info.Length() > 1 && !IS_STRICTLY_NULL(info[1])) {
+    ASSERT_OBJECT_ARGUMENT(1, dataChannelDict);
+
+    if (HAS_OWN_PROPERTY(dataChannelDict, kOrdered)) {
+      DECLARE_OBJECT_PROPERTY(dataChannelDict, kOrdered, orderedVal);
+      init.ordered = orderedVal->BooleanValue();
+    }
+
+    if (HAS_OWN_PROPERTY(dataChannelDict, kMaxPacketLifeTime)) {
+      DECLARE_OBJECT_PROPERTY(dataChannelDict, kMaxPacketLifeTime,
+                              maxPacketLifeTimeVal);
+      ASSERT_PROPERTY_NUMBER(kMaxPacketLifeTime, maxPacketLifeTimeVal,
+                             maxPacketLifeTime);
+
+      if (maxPacketLifeTime->Value() < 0 ||
+          maxPacketLifeTime->Value() > kMaxUnsignedShort) {
+        errorStream << ERROR_PROPERTY_OUT_OF_RANGE(kMaxPacketLifeTime);
+        return Nan::ThrowTypeError(errorStream.str().c_str());
+      }
+
+      init.maxRetransmitTime = maxPacketLifeTime->Int32Value();
+    }
+
+    if (HAS_OWN_PROPERTY(dataChannelDict, kMaxRetransmits)) {
+      DECLARE_OBJECT_PROPERTY(dataChannelDict, kMaxRetransmits,
+                              maxRetransmitsVal);
+      ASSERT_PROPERTY_NUMBER(kMaxRetransmits, maxRetransmitsVal,
+                             maxRetransmits);
+
+      if (maxRetransmits->Value() < 0 ||
+          maxRetransmits->Value() > kMaxUnsignedShort) {
+        errorStream << ERROR_PROPERTY_OUT_OF_RANGE(kMaxRetransmits);
+        return Nan::ThrowTypeError(errorStream.str().c_str());
+      }
+
+      init.maxRetransmits = maxRetransmits->Int32Value();
+    }
+
+    if (init.maxRetransmitTime >= 0 && init.maxRetransmits >= 0) {
+      errorStream << eBothRetransmits;
+      return Nan::ThrowTypeError(errorStream.str().c_str());
+    }
+
+    if (HAS_OWN_PROPERTY(dataChannelDict, kProtocol)) {
+      DECLARE_OBJECT_PROPERTY(dataChannelDict, kProtocol, protocolVal);
+      String::Utf8Value protocol(protocolVal->ToString());
+      init.protocol = *protocol;
+    }
+
+    if (HAS_OWN_PROPERTY(dataChannelDict, kNegotiated)) {
+      DECLARE_OBJECT_PROPERTY(dataChannelDict, kNegotiated, negotiatedVal);
+      init.negotiated = negotiatedVal->BooleanValue();
+    }
+
+    if (HAS_OWN_PROPERTY(dataChannelDict, kId)) {
+      DECLARE_OBJECT_PROPERTY(dataChannelDict, kId, idVal);
+      ASSERT_PROPERTY_NUMBER(kId, idVal, id);
+
+      if (id->Value() < 0 || id->Value() > kMaxDataChannelId) {
+        errorStream << ERROR_PROPERTY_OUT_OF_RANGE(kId);
+        return Nan::ThrowTypeError(errorStream.str().c_str());
+      }
+
+      init.id = id->Int32Value();
+    }
+
+    if (init.negotiated && init.id < 0) {
+      errorStream << eNegotiatedId;
+      return Nan::ThrowTypeError(errorStream.str().c_str());
+    }
+  }
+
+  rtc::scoped_refptr<webrtc::DataChannelInterface> dataChannel =
+      object->_peerConnection->CreateDataChannel(*label, &init);
+
+  if (!dataChannel.get()) {
+    errorStream << eCreateDataChannel;
+    return Nan::ThrowError(errorStream.str().c_str());
+  }
+
+  rtc::scoped_refptr<DataChannelObserver> observer =
+      DataChannelObserver::Create(dataChannel,
+                                  object->_threadGroup->GetSignalingThread(),
+                                  object->_peerConnectionObserver
+                                      ->GetEventQueue());
+  info.GetReturnValue().Set(RTCDataChannel::Create(observer));
+}
+
 NAN_METHOD(RTCPeerConnection::CreateOffer) {
   METHOD_HEADER("RTCPeerConnection", "createOffer");
   UNWRAP_OBJECT(RTCPeerConnection, object);
 
   bool iceRestart = false;
   unsigned char start = 0;
-  rtc::scoped_refptr<webrtc::CreateSessionDescriptionObserver> observer;
+  rtc::scoped_refptr<CreateSessionDescriptionObserver> observer;
 
   if (info.Length() < 2) {
     DECLARE_PROMISE_RESOLVER;
@@ -163,8 +534,7 @@ NAN_METHOD(RTCPeerConnection::CreateOffer) {
       iceRestart = iceRestartVal->ToBoolean()->BooleanValue();
     }
 
-    observer = CreateSessionDescriptionObserver::Create(
-        new Nan::Persistent<Promise::Resolver>(resolver));
+    observer = CreateSessionDescriptionObserver::Create(resolver);
   } else if (info.Length() > 1) {
     if (info.Length() > 2) {
       start = 1;
@@ -177,174 +547,307 @@ NAN_METHOD(RTCPeerConnection::CreateOffer) {
     ASSERT_FUNCTION_ARGUMENT(start, successCallback);
     ASSERT_FUNCTION_ARGUMENT(start + 1, failureCallback);
 
-    observer = CreateSessionDescriptionObserver::Create(
-        new Nan::Persistent<Function>(successCallback),
-        new Nan::Persistent<Function>(failureCallback));
+    observer = CreateSessionDescriptionObserver::Create(successCallback,
+                                                        failureCallback);
   }
 
-  webrtc::FakeConstraints constraints;
-  constraints.AddOptional(webrtc::MediaConstraintsInterface::kIceRestart,
-                          iceRestart);
-
-  object->_peerConnection->CreateOffer(observer, &constraints);
+  object->_operationsChain->Chain(new CreateDescriptionOperation(
+      webrtc::SessionDescriptionInterface::kOffer, iceRestart, observer));
 }
 
-NAN_GETTER(RTCPeerConnection::GetConnectionState) {
-  info.GetReturnValue().Set(LOCAL_STRING("new"));
+NAN_METHOD(RTCPeerConnection::CreateAnswer) {
+  METHOD_HEADER("RTCPeerConnection", "createAnswer");
+  UNWRAP_OBJECT(RTCPeerConnection, object);
+
+  unsigned char start = 0;
+  rtc::scoped_refptr<CreateSessionDescriptionObserver> observer;
+
+  // RTCAnswerOptions has no member yet, it is only validated.
+  if (info.Length() < 2) {
+    DECLARE_PROMISE_RESOLVER;
+
+    if (info.Length() == 1) {
+      ASSERT_REJECT_OBJECT_ARGUMENT(0, options);
+    }
+
+    observer = CreateSessionDescriptionObserver::Create(resolver);
+  } else {
+    if (info.Length() > 2) {
+      start = 1;
+
+      ASSERT_OBJECT_ARGUMENT(0, options);
+    }
+
+    ASSERT_FUNCTION_ARGUMENT(start, successCallback);
+    ASSERT_FUNCTION_ARGUMENT(start + 1, failureCallback);
+
+    observer = CreateSessionDescriptionObserver::Create(successCallback,
+                                                        failureCallback);
+  }
+
+  object->_operationsChain->Chain(new CreateDescriptionOperation(
+      webrtc::SessionDescriptionInterface::kAnswer, false, observer));
 }
 
-NAN_GETTER(RTCPeerConnection::GetCurrentLocalDescription) {
-  info.GetReturnValue().Set(Nan::Null());
+NAN_METHOD(RTCPeerConnection::SetLocalDescription) {
+  METHOD_HEADER("RTCPeerConnection", "setLocalDescription");
+  SetDescription(info, true, &errorStream);
 }
 
-NAN_GETTER(RTCPeerConnection::GetCurrentRemoteDescription) {
-  info.GetReturnValue().Set(Nan::Null());
+NAN_METHOD(RTCPeerConnection::SetRemoteDescription) {
+  METHOD_HEADER("RTCPeerConnection", "setRemoteDescription");
+  SetDescription(info, false, &errorStream);
 }
 
-NAN_GETTER(RTCPeerConnection::GetIceConnectionState) {
+void RTCPeerConnection::SetDescription(Nan::NAN_METHOD_ARGS_TYPE info,
+                                       bool local,
+                                       std::stringstream *errorStream) {
   UNWRAP_OBJECT(RTCPeerConnection, object);
 
-  std::string iceConnectionState;
-  webrtc::PeerConnectionInterface::IceConnectionState state =
-      object->_peerConnection->ice_connection_state();
+  std::string type;
+  Local<String> sdp;
+  rtc::scoped_refptr<SetSessionDescriptionObserver> observer;
 
-  switch (state) {
-    case webrtc::PeerConnectionInterface::kIceConnectionNew:
-      iceConnectionState = kNew;
-      break;
+  if (info.Length() < 2) {
+    DECLARE_PROMISE_RESOLVER;
 
-    case webrtc::PeerConnectionInterface::kIceConnectionChecking:
-      iceConnectionState = kChecking;
-      break;
+    // Without a description, setLocalDescription sets the last created
+    // offer or answer.
+    bool implicit = local && (!info.Length() || info[0]->IsUndefined());
+
+    if (!implicit && !RTCSessionDescription::ReadDescriptionInit(
+            info[0], errorStream, &type, &sdp)) {
+      resolver->Reject(Nan::GetCurrentContext(),
+                       Nan::TypeError(errorStream->str().c_str()));
+      return;
+    }
 
-    case webrtc::PeerConnectionInterface::kIceConnectionConnected:
-      iceConnectionState = kConnected;
-      break;
+    observer = SetSessionDescriptionObserver::Create(resolver);
+  } else {
+    if (!RTCSessionDescription::ReadDescriptionInit(info[0], errorStream,
+                                                    &type, &sdp)) {
+      return Nan::ThrowTypeError(errorStream->str().c_str());
+    }
 
-    case webrtc::PeerConnectionInterface::kIceConnectionCompleted:
-      iceConnectionState = kCompleted;
-      break;
+    if (!info[1]->IsFunction()) {
+      *errorStream << ERROR_ARGUMENT_NOT_FUNCTION(2, "successCallback");
+      return Nan::ThrowTypeError(errorStream->str().c_str());
+    }
 
-    case webrtc::PeerConnectionInterface::kIceConnectionFailed:
-      iceConnectionState = kFailed;
-      break;
+    if (!info[2]->IsFunction()) {
+      *errorStream << ERROR_ARGUMENT_NOT_FUNCTION(3, "failureCallback");
+      return Nan::ThrowTypeError(errorStream->str().c_str());
+    }
 
-    case webrtc::PeerConnectionInterface::kIceConnectionDisconnected:
-      iceConnectionState = kDisconnected;
-      break;
+    observer = SetSessionDescriptionObserver::Create(
+        info[1].As<Function>(), info[2].As<Function>());
+  }
 
-    case webrtc::PeerConnectionInterface::kIceConnectionClosed:
-      iceConnectionState = kClosed;
-      break;
+  // Copied here, parsing happens on the signaling thread.
+  std::string sdpString;
 
-    default:
-      iceConnectionState = kUnknown;
-      break;
+  if (!sdp.IsEmpty()) {
+    sdpString = *String::Utf8Value(sdp);
   }
 
-  info.GetReturnValue().Set(LOCAL_STRING(iceConnectionState));
+  object->_operationsChain->Chain(new SetDescriptionOperation(
+      local, type, sdpString, observer));
 }
 
-NAN_GETTER(RTCPeerConnection::GetIceGatheringState) {
-  UNWRAP_OBJECT(RTCPeerConnection, object);
-
-  std::string iceGatheringState;
-  webrtc::PeerConnectionInterface::IceGatheringState state =
-      object->_peerConnection->ice_gathering_state();
+void RTCPeerConnection::Dispatch(StringId handler, Local<Object> event) {
+  Nan::HandleScope scope;
+  Local<Value> callback = Nan::Get(handle(), StringTable::Get(handler))
+      .ToLocalChecked();
 
-  switch (state) {
-    case webrtc::PeerConnectionInterface::kIceGatheringNew:
-      iceGatheringState = kNew;
-      break;
+  if (!callback->IsFunction()) {
+    return;
+  }
 
-    case webrtc::PeerConnectionInterface::kIceGatheringGathering:
-      iceGatheringState = kChecking;
-      break;
+  const int argc = 1;
+  Local<Value> argv[argc] = { event };
+  Nan::Call(callback.As<Function>(), handle(), argc, argv);
+}
 
-    case webrtc::PeerConnectionInterface::kIceGatheringComplete:
-      iceGatheringState = kConnected;
-      break;
+void RTCPeerConnection::SetSignalingState(
+    webrtc::PeerConnectionInterface::SignalingState state) {
+  _signalingState = state;
 
-    default:
-      iceGatheringState = kUnknown;
-      break;
+  if (state == webrtc::PeerConnectionInterface::kClosed) {
+    LeaveThreadGroup();
   }
-
-  info.GetReturnValue().Set(LOCAL_STRING(iceGatheringState));
 }
 
-NAN_GETTER(RTCPeerConnection::GetPendingLocalDescription) {
-  info.GetReturnValue().Set(Nan::Null());
+void RTCPeerConnection::SetIceGatheringState(
+    webrtc::PeerConnectionInterface::IceGatheringState state) {
+  _iceGatheringState = state;
 }
 
-NAN_GETTER(RTCPeerConnection::GetPendingRemoteDescription) {
-  info.GetReturnValue().Set(Nan::Null());
+void RTCPeerConnection::SetIceConnectionState(
+    webrtc::PeerConnectionInterface::IceConnectionState state) {
+  _iceConnectionState = state;
+
+  if (state == webrtc::PeerConnectionInterface::kIceConnectionClosed) {
+    LeaveThreadGroup();
+  }
 }
 
-NAN_GETTER(RTCPeerConnection::GetSignalingState) {
+NAN_METHOD(RTCPeerConnection::GetStats) {
+  METHOD_HEADER("RTCPeerConnection", "getStats");
   UNWRAP_OBJECT(RTCPeerConnection, object);
+  DECLARE_PROMISE_RESOLVER;
 
-  std::string signalingState;
-  webrtc::PeerConnectionInterface::SignalingState state =
-      object->_peerConnection->signaling_state();
+  // Non-standard: getStats(array[, offset]) writes the counters listed in
+  // RTCPeerConnection.statsSchema into array[offset...] instead of building
+  // a report, so that polling many connections creates no garbage.
+  GetStatsEvent *event;
+
+  if (info.Length() > 0 && !IS_STRICTLY_NULL(info[0])) {
+    GetStatsEvent::Mode mode;
+
+    if (info[0]->IsFloat64Array()) {
+      mode = GetStatsEvent::kModeFloat64;
+#if V8_MAJOR_VERSION > 6 || (V8_MAJOR_VERSION == 6 && V8_MINOR_VERSION >= 7)
+    } else if (info[0]->IsBigUint64Array()) {
+      mode = GetStatsEvent::kModeBigUint64;
+#endif
+    } else {
+      errorStream << eStatsArray;
+      resolver->Reject(Nan::GetCurrentContext(),
+                       Nan::TypeError(errorStream.str().c_str()));
+      return;
+    }
 
-  switch (state) {
-    case webrtc::PeerConnectionInterface::kStable:
-      signalingState = kStable;
-      break;
+    double offset = 0;
 
-    case webrtc::PeerConnectionInterface::kHaveLocalOffer:
-      signalingState = kHaveLocalOffer;
-      break;
+    // Kept as a double for the range check, NaN and fractions would
+    // otherwise be truncated onto another row of a shared array.
+    if (info.Length() > 1 && !info[1]->IsUndefined()) {
+      if (!info[1]->IsNumber() ||
+          info[1]->NumberValue() != std::floor(info[1]->NumberValue())) {
+        errorStream << eStatsOffset;
+        resolver->Reject(Nan::GetCurrentContext(),
+                         Nan::TypeError(errorStream.str().c_str()));
+        return;
+      }
 
-    case webrtc::PeerConnectionInterface::kHaveLocalPrAnswer:
-      signalingState = kHaveLocalPranswer;
-      break;
+      offset = info[1]->NumberValue();
+    }
 
-    case webrtc::PeerConnectionInterface::kHaveRemoteOffer:
-      signalingState = kHaveRemoteOffer;
-      break;
+    Local<TypedArray> array = info[0].As<TypedArray>();
 
-    case webrtc::PeerConnectionInterface::kHaveRemotePrAnswer:
-      signalingState = kHaveRemotePranswer;
-      break;
+    if (array->Length() < kStatsFieldCount || offset < 0 ||
+        offset > array->Length() - kStatsFieldCount) {
+      errorStream << eStatsRange;
+      resolver->Reject(Nan::GetCurrentContext(),
+                       Nan::RangeError(errorStream.str().c_str()));
+      return;
+    }
 
-    default:
-      signalingState = kUnknown;
-      break;
+    event = new GetStatsEvent(resolver, mode, array,
+                              static_cast<uint32_t>(offset));
+  } else {
+    event = new GetStatsEvent(resolver);
   }
 
-  info.GetReturnValue().Set(LOCAL_STRING(signalingState));
+  object->_peerConnection->GetStats(RTCStatsCollectorObserver::Create(event));
 }
 
-RTCPeerConnection::GenerateCertificateWorker::GenerateCertificateWorker
-    (Persistent<Promise::Resolver> *resolver, const rtc::KeyParams& params)
-    : Nan::AsyncWorker(nullptr), _params(params), _resolver(resolver) {
-}
+NAN_METHOD(RTCPeerConnection::GetStatsHistory) {
+  UNWRAP_OBJECT(RTCPeerConnection, object);
+
+  // Non-standard: returns the samples taken by the native stats sampler,
+  // oldest first, one row of configure({ stats: { fields } }) values each.
+  std::vector<double> samples;
+
+  if (object->_statsHistory.get()) {
+    object->_statsHistory->GetSamples(&samples);
+  }
+
+  Local<ArrayBuffer> buffer = ArrayBuffer::New(
+      Isolate::GetCurrent(), samples.size() * sizeof(double));
+  Local<Float64Array> array = Float64Array::New(buffer, 0, samples.size());
 
-void RTCPeerConnection::GenerateCertificateWorker::Execute() {
-  rtc::RTCCertificateGenerator *generator = Globals::GetCertificateGenerator();
+  if (!samples.empty()) {
+    memcpy(buffer->GetContents().Data(), samples.data(),
+           samples.size() * sizeof(double));
+  }
 
-  _certificate = generator->GenerateCertificate(_params,
-                                                rtc::Optional<uint64_t>());
+  info.GetReturnValue().Set(array);
 }
 
-void RTCPeerConnection::GenerateCertificateWorker::WorkComplete() {
-  Nan::HandleScope scope;
-  Local<Promise::Resolver> resolver = Nan::New(*_resolver);
+NAN_METHOD(RTCPeerConnection::SetStatsAlert) {
+  METHOD_HEADER("RTCPeerConnection", "setStatsAlert");
+  UNWRAP_OBJECT(RTCPeerConnection, object);
+  ASSERT_ARGUMENTS_COUNT(2);
+
+  // Non-standard: fires onstatsalert when a sampled value goes above the
+  // threshold. A null threshold removes the alert.
+  ASSERT_PROPERTY_STRING("field", info[0], fieldName);
+  StatsField field;
+
+  if (!GetStatsField(*fieldName, &field)) {
+    errorStream << "The provided value '" << std::string(*fieldName);
+    errorStream << "' is not a valid stats field.";
+    return Nan::ThrowTypeError(errorStream.str().c_str());
+  }
+
+  if (!info[1]->IsNull() &&
+      !(info[1]->IsNumber() && !std::isnan(info[1]->NumberValue()))) {
+    errorStream << eStatsThreshold;
+    return Nan::ThrowTypeError(errorStream.str().c_str());
+  }
 
-  if (!_certificate.get()) {
-    std::stringstream errorStream;
+  if (!object->_statsHistory.get()) {
+    errorStream << eStatsSampler;
+    return Nan::ThrowError(errorStream.str().c_str());
+  }
 
-    errorStream << eFailure;
-    resolver->Reject(Nan::TypeError(errorStream.str().c_str()));
+  if (info[1]->IsNull()) {
+    object->_statsHistory->ClearAlert(field);
   } else {
-    resolver->Resolve(RTCCertificate::Create(_certificate));
+    object->_statsHistory->SetAlert(field, info[1]->NumberValue());
   }
+}
+
+NAN_GETTER(RTCPeerConnection::GetConnectionState) {
+  info.GetReturnValue().Set(StringTable::Get(kStringNew));
+}
+
+NAN_GETTER(RTCPeerConnection::GetCurrentLocalDescription) {
+  info.GetReturnValue().Set(Nan::Null());
+}
+
+NAN_GETTER(RTCPeerConnection::GetCurrentRemoteDescription) {
+  info.GetReturnValue().Set(Nan::Null());
+}
 
-  Isolate::GetCurrent()->RunMicrotasks();
-  _resolver->Reset();
-  delete _resolver;
+NAN_GETTER(RTCPeerConnection::GetIceConnectionState) {
+  UNWRAP_OBJECT(RTCPeerConnection, object);
+
+  info.GetReturnValue().Set(StringTable::Get(
+      kIceConnectionStates, object->_iceConnectionState, kStringUnknown));
+}
+
+NAN_GETTER(RTCPeerConnection::GetIceGatheringState) {
+  UNWRAP_OBJECT(RTCPeerConnection, object);
+
+  info.GetReturnValue().Set(StringTable::Get(
+      kIceGatheringStates, object->_iceGatheringState, kStringUnknown));
+}
+
+NAN_GETTER(RTCPeerConnection::GetPendingLocalDescription) {
+  info.GetReturnValue().Set(Nan::Null());
+}
+
+NAN_GETTER(RTCPeerConnection::GetPendingRemoteDescription) {
+  info.GetReturnValue().Set(Nan::Null());
+}
+
+NAN_GETTER(RTCPeerConnection::GetSignalingState) {
+  UNWRAP_OBJECT(RTCPeerConnection, object);
+
+  info.GetReturnValue().Set(StringTable::Get(
+      kSignalingStates, object->_signalingState, kStringUnknown));
 }
 
 NAN_METHOD(RTCPeerConnection::GenerateCertificate) {
@@ -425,6 +928,27 @@ NAN_METHOD(RTCPeerConnection::GenerateCertificate) {
     return;
   }
 
-  Nan::AsyncQueueWorker(new GenerateCertificateWorker(
-      new Nan::Persistent<Promise::Resolver>(resolver), keyParams));
+  if (!Globals::Start()) {
+    errorStream << eThreads;
+    resolver->Reject(Nan::GetCurrentContext(),
+                     Nan::Error(errorStream.str().c_str()));
+    return;
+  }
+
+  CertificatePool *certificatePool = Globals::GetCertificatePool();
+  CertificatePool::KeyType keyType;
+
+  if (certificatePool &&
+      CertificatePool::GetKeyType(keyParams, &keyType)) {
+    rtc::scoped_refptr<rtc::RTCCertificate> certificate =
+        certificatePool->Take(keyType);
+
+    if (certificate.get()) {
+      resolver->Resolve(Nan::GetCurrentContext(),
+                        RTCCertificate::Create(certificate));
+      return;
+    }
+  }
+
+  CertificateGenerator::Generate(keyParams, resolver);
 }
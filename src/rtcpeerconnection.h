@@ -19,25 +19,70 @@
 
 #include <nan.h>
 #include <webrtc/api/jsep.h>
+#include <webrtc/api/peerconnectioninterface.h>
+#include <sstream>
 #include <string>
+#include "addondata.h"
+#include "stringtable.h"
 
 using namespace v8;
 
+class OperationsChain;
 class PeerConnectionObserver;
+class StatsHistory;
+class ThreadGroup;
 class RTCPeerConnection : public Nan::ObjectWrap {
  public:
   static NAN_MODULE_INIT(Init);
 
+  // Calls the on<event> handler of this connection, if one is set, with
+  // the connection as receiver. Exceptions are left to the caller.
+  void Dispatch(StringId handler, Local<Object> event);
+
+  // The states are mirrored from the observer events, so that the getters
+  // do not need to block on the signaling thread.
+  void SetSignalingState(
+      webrtc::PeerConnectionInterface::SignalingState state);
+  void SetIceGatheringState(
+      webrtc::PeerConnectionInterface::IceGatheringState state);
+  void SetIceConnectionState(
+      webrtc::PeerConnectionInterface::IceConnectionState state);
+
+  // Releases the native peer connection and detaches from the observer.
+  // Called by the destructor, or earlier when the environment owning the
+  // connection goes away. Safe to call more than once.
+  void Teardown();
+
  private:
-  explicit RTCPeerConnection(
+  RTCPeerConnection(
+      ThreadGroup *threadGroup,
+      const rtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface>&
+          peerConnectionFactory,
       const webrtc::PeerConnectionInterface::RTCConfiguration& config,
-      const webrtc::MediaConstraintsInterface& constraints);
+      const webrtc::MediaConstraintsInterface& constraints,
+      uint32_t iceCandidateBatchWindow);
   ~RTCPeerConnection();
 
+  // Stops counting the connection in its thread group, once it is closed or
+  // torn down, whichever comes first. There is no close() yet, so a
+  // connection is usually counted until it is garbage collected.
+  void LeaveThreadGroup();
+
   static NAN_METHOD(New);
+  static NAN_METHOD(CreateDataChannel);
   static NAN_METHOD(CreateOffer);
+  static NAN_METHOD(CreateAnswer);
+  static NAN_METHOD(SetLocalDescription);
+  static NAN_METHOD(SetRemoteDescription);
+  static NAN_METHOD(GetStats);
+  static NAN_METHOD(GetStatsHistory);
+  static NAN_METHOD(SetStatsAlert);
   static NAN_METHOD(GenerateCertificate);
 
+  // Shared by setLocalDescription and setRemoteDescription.
+  static void SetDescription(Nan::NAN_METHOD_ARGS_TYPE info, bool local,
+                             std::stringstream *errorStream);
+
   static NAN_GETTER(GetConnectionState);
   static NAN_GETTER(GetCurrentLocalDescription);
   static NAN_GETTER(GetCurrentRemoteDescription);
@@ -47,28 +92,23 @@ class RTCPeerConnection : public Nan::ObjectWrap {
   static NAN_GETTER(GetPendingRemoteDescription);
   static NAN_GETTER(GetSignalingState);
 
-  class GenerateCertificateWorker : public Nan::AsyncWorker {
-   public:
-    explicit GenerateCertificateWorker(Persistent<Promise::Resolver> *resolver,
-                                       const rtc::KeyParams& params);
-    ~GenerateCertificateWorker() {}
-
-    void Execute();
-    void WorkComplete();
-
-   private:
-    const rtc::KeyParams _params;
-    Persistent<Promise::Resolver> *_resolver;
-    rtc::scoped_refptr<rtc::RTCCertificate> _certificate;
-  };
-
-  static Nan::Persistent<FunctionTemplate> constructor;
+  static inline Nan::Persistent<FunctionTemplate>& constructor() {
+    return AddonData::Get()->peerConnectionTemplate;
+  }
 
  protected:
+  ThreadGroup *_threadGroup;
   rtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface>
       _peerConnectionFactory;
   rtc::scoped_refptr<webrtc::PeerConnectionInterface> _peerConnection;
   rtc::scoped_refptr<PeerConnectionObserver> _peerConnectionObserver;
+  rtc::scoped_refptr<OperationsChain> _operationsChain;
+  rtc::scoped_refptr<StatsHistory> _statsHistory;
+
+  webrtc::PeerConnectionInterface::SignalingState _signalingState;
+  webrtc::PeerConnectionInterface::IceGatheringState _iceGatheringState;
+  webrtc::PeerConnectionInterface::IceConnectionState _iceConnectionState;
+  bool _countedInThreadGroup;
 };
 
 #endif  // RTCPEERCONNECTION_H_
@@ -19,6 +19,8 @@
 #include <iostream>
 #include "common.h"
 #include "rtcsessiondescription.h"
+#include "sessiondescriptionparser.h"
+#include "stringtable.h"
 
 static const char sRTCSessionDescription[] = "RTCSessionDescription";
 
@@ -30,89 +32,240 @@ const char RTCSessionDescription::kOffer[] = "offer";
 const char RTCSessionDescription::kPranswer[] = "pranswer";
 const char RTCSessionDescription::kRollback[] = "rollback";
 
+static const char kParse[] = "parse";
+
+static const char *const kTypes[] = {
+  RTCSessionDescription::kAnswer,
+  RTCSessionDescription::kOffer,
+  RTCSessionDescription::kPranswer,
+  RTCSessionDescription::kRollback,
+};
+
+static const StringId kTypeStrings[] = {
+  kStringAnswer,
+  kStringOffer,
+  kStringPranswer,
+  kStringRollback,
+};
+
+static const size_t kTypeCount = sizeof(kTypes) / sizeof(kTypes[0]);
+
+static_assert(sizeof(kTypeStrings) / sizeof(kTypeStrings[0]) == kTypeCount,
+              "kTypeStrings is out of sync with kTypes");
+
+// Keeps a serialized SDP in native memory for the lifetime of its string.
+class ExternalSdp : public String::ExternalOneByteStringResource {
+ public:
+  explicit ExternalSdp(std::string *sdp) {
+    _sdp.swap(*sdp);
+  }
+
+  const char *data() const { return _sdp.data(); }
+  size_t length() const { return _sdp.size(); }
+
+ private:
+  std::string _sdp;
+};
+
 NAN_MODULE_INIT(RTCSessionDescription::Init) {
   Local<FunctionTemplate> ctor = Nan::New<FunctionTemplate>(New);
   ctor->SetClassName(LOCAL_STRING(sRTCSessionDescription));
   ctor->InstanceTemplate()->SetInternalFieldCount(1);
 
   Local<ObjectTemplate> tpl = ctor->InstanceTemplate();
-  Nan::SetAccessor(tpl, LOCAL_STRING(kSdp), GetSdp);
-  Nan::SetAccessor(tpl, LOCAL_STRING(kType), GetType);
+  Nan::SetAccessor(tpl, StringTable::Get(kStringSdp), GetSdp);
+  Nan::SetAccessor(tpl, StringTable::Get(kStringType), GetType);
+
+  Nan::SetMethod(ctor, kParse, Parse);
 
   constructor().Reset(Nan::GetFunction(ctor).ToLocalChecked());
   Nan::Set(target, LOCAL_STRING(sRTCSessionDescription), ctor->GetFunction());
 }
 
 RTCSessionDescription::RTCSessionDescription(
-    webrtc::SessionDescriptionInterface *sessionDescription)
-    : _sessionDescription(sessionDescription) {
+    webrtc::SessionDescriptionInterface *sessionDescription,
+    Local<String> sdp)
+    : _sessionDescription(sessionDescription),
+      _sdp(sdp) {
 }
 
 RTCSessionDescription::~RTCSessionDescription() {
+  _sdp.Reset();
   delete _sessionDescription;
 }
 
-Local<Object> RTCSessionDescription::Create(const std::string &type,
-                                            const std::string &sdp) {
+Local<Object> RTCSessionDescription::Create(
+    webrtc::SessionDescriptionInterface *sessionDescription,
+    Local<String> sdp) {
   Local<Function> cons = Nan::New(RTCSessionDescription::constructor());
-  Local<Object> descriptionInitDict = Nan::New<Object>();
-  descriptionInitDict->Set(LOCAL_STRING(kSdp), LOCAL_STRING(sdp));
-  descriptionInitDict->Set(LOCAL_STRING(kType), LOCAL_STRING(type));
 
-  const int argc = 1;
-  Local<Value> argv[1] = { descriptionInitDict };
+  const int argc = 2;
+  Local<Value> argv[2] = {
+    Nan::New<External>(sessionDescription),
+    sdp.IsEmpty() ? Nan::Undefined().As<Value>() : sdp.As<Value>()
+  };
   return Nan::NewInstance(cons, argc, argv).ToLocalChecked();
 }
 
+// SDP is ASCII in practice and then lives outside the V8 heap. Other
+// contents, such as UTF-8 in the s= line, fall back to a regular string,
+// since a one-byte string would read them as Latin-1.
+Local<String> RTCSessionDescription::NewSdpString(std::string *sdp) {
+  for (size_t i = 0; i < sdp->size(); ++i) {
+    if (static_cast<unsigned char>((*sdp)[i]) >= 0x80) {
+      return Nan::New(*sdp).ToLocalChecked();
+    }
+  }
+
+  return Nan::New<String>(new ExternalSdp(sdp)).ToLocalChecked();
+}
+
+bool RTCSessionDescription::ReadDescriptionInit(
+    Local<Value> value, std::stringstream *errorStream, std::string *type,
+    Local<String> *sdp) {
+  if (!value->IsObject()) {
+    *errorStream << ERROR_ARGUMENT_NOT_OBJECT(1, "descriptionInitDict");
+    return false;
+  }
+
+  Local<Object> descriptionInitDict = value->ToObject();
+
+  if (!HAS_OWN_PROPERTY(descriptionInitDict, kType)) {
+    *errorStream << ERROR_PROPERTY_NOT_DEFINED(kType);
+    return false;
+  }
+
+  DECLARE_OBJECT_PROPERTY(descriptionInitDict, kType, typeVal);
+
+  if (!typeVal->IsString()) {
+    *errorStream << ERROR_PROPERTY_NOT_STRING(kType);
+    return false;
+  }
+
+  String::Utf8Value typeStr(typeVal->ToString());
+
+  if (strcmp(kAnswer, *typeStr) &&
+      strcmp(kOffer, *typeStr) &&
+      strcmp(kPranswer, *typeStr) &&
+      strcmp(kRollback, *typeStr)) {
+    *errorStream << "The provided value '";
+    *errorStream << std::string(*typeStr);
+    *errorStream << "' is not a valid enum value of type RTCSdpType.";
+    return false;
+  }
+
+  if (!HAS_OWN_PROPERTY(descriptionInitDict, kSdp)) {
+    *errorStream << ERROR_PROPERTY_NOT_DEFINED(kSdp);
+    return false;
+  }
+
+  DECLARE_OBJECT_PROPERTY(descriptionInitDict, kSdp, sdpVal);
+
+  if (!sdpVal->IsString()) {
+    *errorStream << ERROR_PROPERTY_NOT_STRING(kSdp);
+    return false;
+  }
+
+  *type = *typeStr;
+  *sdp = sdpVal.As<String>();
+  return true;
+}
+
 NAN_METHOD(RTCSessionDescription::New) {
   CONSTRUCTOR_HEADER("RTCSessionDescription");
 
   ASSERT_CONSTRUCT_CALL;
-  ASSERT_SINGLE_ARGUMENT;
 
-  ASSERT_OBJECT_ARGUMENT(0, descriptionInitDict);
+  // Native descriptions are passed as an External by Create(), skipping the
+  // init dictionary and the parser. The SDP string comes along when the
+  // description was parsed from it.
+  if (info.Length() >= 1 && info[0]->IsExternal()) {
+    webrtc::SessionDescriptionInterface *desc =
+        static_cast<webrtc::SessionDescriptionInterface *>(
+            info[0].As<External>()->Value());
+    Local<String> sdpStr;
 
-  ASSERT_OBJECT_PROPERTY(descriptionInitDict, kType, typeVal);
-  ASSERT_PROPERTY_STRING(kType, typeVal, type);
+    if (info.Length() > 1 && info[1]->IsString()) {
+      sdpStr = info[1].As<String>();
+    } else {
+      std::string sdp;
+      desc->ToString(&sdp);
+      sdpStr = NewSdpString(&sdp);
+    }
 
-  if (strcmp(kAnswer, *type) &&
-      strcmp(kOffer, *type) &&
-      strcmp(kPranswer, *type) &&
-      strcmp(kRollback, *type)) {
-    errorStream << "The provided value '";
-    errorStream << std::string(*type);
-    errorStream << "' is not a valid enum value of type RTCSdpType.";
-    return Nan::ThrowTypeError(errorStream.str().c_str());
+    RTCSessionDescription *rtcSessionDescription =
+        new RTCSessionDescription(desc, sdpStr);
+    rtcSessionDescription->Wrap(info.This());
+
+    info.GetReturnValue().Set(info.This());
+    return;
   }
 
-  ASSERT_OBJECT_PROPERTY(descriptionInitDict, kSdp, sdpVal);
-  ASSERT_PROPERTY_STRING(kSdp, sdpVal, sdp);
+  ASSERT_SINGLE_ARGUMENT;
+
+  std::string type;
+  Local<String> sdpStr;
 
+  if (!ReadDescriptionInit(info[0], &errorStream, &type, &sdpStr)) {
+    return Nan::ThrowTypeError(errorStream.str().c_str());
+  }
+
+  String::Utf8Value sdp(sdpStr);
   webrtc::SdpParseError error;
   webrtc::SessionDescriptionInterface *desc;
-  desc = webrtc::CreateSessionDescription(*type, *sdp, &error);
+  desc = webrtc::CreateSessionDescription(type, *sdp, &error);
 
   if (!desc) {
     errorStream << error.description;
     return Nan::ThrowTypeError(errorStream.str().c_str());
   }
 
-  RTCSessionDescription *rtcIceCandidate = new RTCSessionDescription(desc);
-  rtcIceCandidate->Wrap(info.This());
+  RTCSessionDescription *rtcSessionDescription =
+      new RTCSessionDescription(desc, sdpStr);
+  rtcSessionDescription->Wrap(info.This());
 
   info.GetReturnValue().Set(info.This());
 }
 
+NAN_METHOD(RTCSessionDescription::Parse) {
+  METHOD_HEADER("RTCSessionDescription", "parse");
+  DECLARE_PROMISE_RESOLVER;
+
+  // Non-standard: parses the SDP off the main thread, for large
+  // renegotiations.
+  ASSERT_REJECT_SINGLE_ARGUMENT;
+
+  std::string type;
+  Local<String> sdpStr;
+
+  if (!ReadDescriptionInit(info[0], &errorStream, &type, &sdpStr)) {
+    resolver->Reject(Nan::GetCurrentContext(),
+                     Nan::TypeError(errorStream.str().c_str()));
+    return;
+  }
+
+  SessionDescriptionParser::Parse(type, sdpStr, resolver);
+}
+
+Local<String> RTCSessionDescription::GetTypeString(const std::string &type) {
+  for (size_t i = 0; i < kTypeCount; ++i) {
+    if (type == kTypes[i]) {
+      return StringTable::Get(kTypeStrings[i]);
+    }
+  }
+
+  return LOCAL_STRING(type);
+}
+
 NAN_GETTER(RTCSessionDescription::GetType) {
   UNWRAP_OBJECT(RTCSessionDescription, object);
 
-  info.GetReturnValue().Set(LOCAL_STRING(object->_sessionDescription->type()));
+  info.GetReturnValue().Set(
+      GetTypeString(object->_sessionDescription->type()));
 }
 
 NAN_GETTER(RTCSessionDescription::GetSdp) {
   UNWRAP_OBJECT(RTCSessionDescription, object);
-  std::string sdp;
 
-  object->_sessionDescription->ToString(&sdp);
-  info.GetReturnValue().Set(LOCAL_STRING(sdp));
+  info.GetReturnValue().Set(Nan::New(object->_sdp));
 }
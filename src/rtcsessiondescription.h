@@ -19,7 +19,9 @@
 
 #include <nan.h>
 #include <webrtc/api/jsep.h>
+#include <sstream>
 #include <string>
+#include "addondata.h"
 
 using namespace v8;
 
@@ -27,13 +29,24 @@ class RTCSessionDescription : public Nan::ObjectWrap {
  public:
   static NAN_MODULE_INIT(Init);
 
-  static Local<Object> Create(const std::string& type, const std::string &sdp);
+  // Wraps a description created natively, taking ownership of it. The SDP
+  // it was parsed from may be given, it is serialized again otherwise.
+  static Local<Object> Create(
+      webrtc::SessionDescriptionInterface *sessionDescription,
+      Local<String> sdp = Local<String>());
+
+  // The RTCSdpType string of a native description type.
+  static Local<String> GetTypeString(const std::string &type);
 
   static inline Nan::Persistent<v8::Function>& constructor() {
-    static Nan::Persistent<v8::Function> _constructor;
-    return _constructor;
+    return AddonData::Get()->sessionDescriptionConstructor;
   }
 
+  // Validates an RTCSessionDescriptionInit, any failure being a TypeError.
+  static bool ReadDescriptionInit(Local<Value> value,
+                                  std::stringstream *errorStream,
+                                  std::string *type, Local<String> *sdp);
+
   static const char kSdp[];
   static const char kType[];
 
@@ -43,17 +56,25 @@ class RTCSessionDescription : public Nan::ObjectWrap {
   static const char kRollback[];
 
  private:
-  explicit RTCSessionDescription(
-      webrtc::SessionDescriptionInterface *sessionDescription);
+  RTCSessionDescription(
+      webrtc::SessionDescriptionInterface *sessionDescription,
+      Local<String> sdp);
   ~RTCSessionDescription();
 
   static NAN_METHOD(New);
+  static NAN_METHOD(Parse);
+
+  static Local<String> NewSdpString(std::string *sdp);
 
   static NAN_GETTER(GetType);
   static NAN_GETTER(GetSdp);
 
  protected:
   webrtc::SessionDescriptionInterface *_sessionDescription;
+
+  // The SDP as given to the constructor, or serialized once for native
+  // descriptions, returned as is by the sdp getter.
+  Nan::Persistent<String> _sdp;
 };
 
 #endif  // RTCSESSIONDESCRIPTION_H_
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <webrtc/api/jsep.h>
+#include "event/sessiondescriptionparsedevent.h"
+#include "paralleljob.h"
+#include "sessiondescriptionparser.h"
+
+class ParseSessionDescriptionJob : public ParallelJob {
+ public:
+  ParseSessionDescriptionJob(const std::string &type, Local<String> sdp,
+                             Local<Promise::Resolver> resolver)
+      : _event(new SessionDescriptionParsedEvent(resolver, sdp)),
+        _type(type),
+        _sdp(*String::Utf8Value(sdp)) {
+  }
+
+ protected:
+  size_t Prepare() {
+    return 1;
+  }
+
+  void Run(size_t begin, size_t end) {
+    webrtc::SdpParseError error;
+    webrtc::SessionDescriptionInterface *desc =
+        webrtc::CreateSessionDescription(_type, _sdp, &error);
+
+    if (!desc) {
+      _event->SetError(error.description);
+      return;
+    }
+
+    _event->SetSessionDescription(desc);
+  }
+
+  void Finish() {
+    GetEventQueue()->PushEvent(_event);
+  }
+
+ private:
+  SessionDescriptionParsedEvent *_event;
+  const std::string _type;
+  const std::string _sdp;
+};
+
+void SessionDescriptionParser::Parse(const std::string &type,
+                                     Local<String> sdp,
+                                     Local<Promise::Resolver> resolver) {
+  ParallelJob *job = new ParseSessionDescriptionJob(type, sdp, resolver);
+  job->Start();
+}
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SESSIONDESCRIPTIONPARSER_H_
+#define SESSIONDESCRIPTIONPARSER_H_
+
+#include <nan.h>
+#include <string>
+
+using namespace v8;
+
+// Parses a session description on the libuv threadpool, large SDPs taking
+// milliseconds which would otherwise be spent on the main thread.
+class SessionDescriptionParser {
+ public:
+  // Resolves with an RTCSessionDescription keeping 'sdp' as is, or rejects
+  // with the parser message. 'type' must have been validated.
+  static void Parse(const std::string &type, Local<String> sdp,
+                    Local<Promise::Resolver> resolver);
+};
+
+#endif  // SESSIONDESCRIPTIONPARSER_H_
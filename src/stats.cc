@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <webrtc/api/stats/rtcstats_objects.h>
+#include <algorithm>
+#include <cstring>
+#include "stats.h"
+
+static const char *const kFieldNames[kStatsFieldCount] = {
+  "timestamp",
+  "currentRoundTripTime",
+  "availableOutgoingBitrate",
+  "bytesSent",
+  "bytesReceived",
+  "packetsSent",
+  "packetsReceived",
+  "packetsLost",
+  "jitter",
+  "messagesSent",
+  "messagesReceived",
+};
+
+template <typename T>
+static T ValueOr(const webrtc::RTCStatsMember<T> &member, T fallback) {
+  return member.is_defined() ? *member : fallback;
+}
+
+StatsSummary::StatsSummary()
+    : timestampUs(0),
+      currentRoundTripTime(0),
+      availableOutgoingBitrate(0),
+      bytesSent(0),
+      bytesReceived(0),
+      packetsSent(0),
+      packetsReceived(0),
+      packetsLost(0),
+      jitter(0),
+      messagesSent(0),
+      messagesReceived(0) {
+}
+
+void StatsSummary::WriteFloat64(double *values) const {
+  values[kStatsTimestamp] = timestampUs / 1000.0;
+  values[kStatsCurrentRoundTripTime] = currentRoundTripTime;
+  values[kStatsAvailableOutgoingBitrate] = availableOutgoingBitrate;
+  values[kStatsBytesSent] = static_cast<double>(bytesSent);
+  values[kStatsBytesReceived] = static_cast<double>(bytesReceived);
+  values[kStatsPacketsSent] = static_cast<double>(packetsSent);
+  values[kStatsPacketsReceived] = static_cast<double>(packetsReceived);
+  values[kStatsPacketsLost] = static_cast<double>(packetsLost);
+  values[kStatsJitter] = jitter;
+  values[kStatsMessagesSent] = static_cast<double>(messagesSent);
+  values[kStatsMessagesReceived] = static_cast<double>(messagesReceived);
+}
+
+void StatsSummary::WriteUint64(uint64_t *values) const {
+  values[kStatsTimestamp] = static_cast<uint64_t>(timestampUs);
+  values[kStatsCurrentRoundTripTime] =
+      static_cast<uint64_t>(currentRoundTripTime * 1000000);
+  values[kStatsAvailableOutgoingBitrate] =
+      static_cast<uint64_t>(availableOutgoingBitrate);
+  values[kStatsBytesSent] = bytesSent;
+  values[kStatsBytesReceived] = bytesReceived;
+  values[kStatsPacketsSent] = packetsSent;
+  values[kStatsPacketsReceived] = packetsReceived;
+  values[kStatsPacketsLost] = packetsLost;
+  values[kStatsJitter] = static_cast<uint64_t>(jitter * 1000000);
+  values[kStatsMessagesSent] = messagesSent;
+  values[kStatsMessagesReceived] = messagesReceived;
+}
+
+const char *GetStatsFieldName(StatsField field) {
+  return kFieldNames[field];
+}
+
+bool GetStatsField(const char *name, StatsField *field) {
+  for (int i = 0; i < kStatsFieldCount; ++i) {
+    if (!strcmp(kFieldNames[i], name)) {
+      *field = static_cast<StatsField>(i);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void SummarizeStats(const webrtc::RTCStatsReport &report,
+                    StatsSummary *summary) {
+  for (const webrtc::RTCStats &stats : report) {
+    summary->timestampUs = std::max(summary->timestampUs,
+                                    stats.timestamp_us());
+
+    if (stats.type() == webrtc::RTCIceCandidatePairStats::kType) {
+      const webrtc::RTCIceCandidatePairStats &pair =
+          stats.cast_to<webrtc::RTCIceCandidatePairStats>();
+
+      if (!ValueOr(pair.nominated, false)) {
+        continue;
+      }
+
+      summary->currentRoundTripTime =
+          ValueOr(pair.current_round_trip_time, 0.0);
+      summary->availableOutgoingBitrate =
+          ValueOr(pair.available_outgoing_bitrate, 0.0);
+      summary->bytesSent = ValueOr<uint64_t>(pair.bytes_sent, 0);
+      summary->bytesReceived = ValueOr<uint64_t>(pair.bytes_received, 0);
+    } else if (stats.type() == webrtc::RTCInboundRTPStreamStats::kType) {
+      const webrtc::RTCInboundRTPStreamStats &inbound =
+          stats.cast_to<webrtc::RTCInboundRTPStreamStats>();
+
+      summary->packetsReceived += ValueOr<uint32_t>(inbound.packets_received,
+                                                    0);
+      summary->packetsLost += ValueOr<uint32_t>(inbound.packets_lost, 0);
+      summary->jitter = std::max(summary->jitter,
+                                 ValueOr(inbound.jitter, 0.0));
+    } else if (stats.type() == webrtc::RTCOutboundRTPStreamStats::kType) {
+      const webrtc::RTCOutboundRTPStreamStats &outbound =
+          stats.cast_to<webrtc::RTCOutboundRTPStreamStats>();
+
+      summary->packetsSent += ValueOr<uint32_t>(outbound.packets_sent, 0);
+    } else if (stats.type() == webrtc::RTCDataChannelStats::kType) {
+      const webrtc::RTCDataChannelStats &channel =
+          stats.cast_to<webrtc::RTCDataChannelStats>();
+
+      summary->messagesSent += ValueOr<uint32_t>(channel.messages_sent, 0);
+      summary->messagesReceived +=
+          ValueOr<uint32_t>(channel.messages_received, 0);
+    }
+  }
+}
+
+template <typename T>
+static void CopyNumbers(const webrtc::RTCStatsMemberInterface *member,
+                        StatsMember *copy) {
+  const std::vector<T> &values =
+      *member->cast_to<webrtc::RTCStatsMember<std::vector<T> > >();
+
+  copy->type = StatsMember::kNumberSequence;
+  copy->numberValues.assign(values.begin(), values.end());
+}
+
+static bool CopyMember(const webrtc::RTCStatsMemberInterface *member,
+                       StatsMember *copy) {
+  copy->name = member->name();
+
+  switch (member->type()) {
+    case webrtc::RTCStatsMemberInterface::kBool:
+      copy->type = StatsMember::kBool;
+      copy->boolValue =
+          *member->cast_to<webrtc::RTCStatsMember<bool> >();
+      return true;
+
+    case webrtc::RTCStatsMemberInterface::kInt32:
+      copy->type = StatsMember::kNumber;
+      copy->numberValue =
+          *member->cast_to<webrtc::RTCStatsMember<int32_t> >();
+      return true;
+
+    case webrtc::RTCStatsMemberInterface::kUint32:
+      copy->type = StatsMember::kNumber;
+      copy->numberValue =
+          *member->cast_to<webrtc::RTCStatsMember<uint32_t> >();
+      return true;
+
+    case webrtc::RTCStatsMemberInterface::kInt64:
+      copy->type = StatsMember::kNumber;
+      copy->numberValue = static_cast<double>(
+          *member->cast_to<webrtc::RTCStatsMember<int64_t> >());
+      return true;
+
+    case webrtc::RTCStatsMemberInterface::kUint64:
+      copy->type = StatsMember::kNumber;
+      copy->numberValue = static_cast<double>(
+          *member->cast_to<webrtc::RTCStatsMember<uint64_t> >());
+      return true;
+
+    case webrtc::RTCStatsMemberInterface::kDouble:
+      copy->type = StatsMember::kNumber;
+      copy->numberValue =
+          *member->cast_to<webrtc::RTCStatsMember<double> >();
+      return true;
+
+    case webrtc::RTCStatsMemberInterface::kString:
+      copy->type = StatsMember::kString;
+      copy->stringValue =
+          *member->cast_to<webrtc::RTCStatsMember<std::string> >();
+      return true;
+
+    case webrtc::RTCStatsMemberInterface::kSequenceBool:
+      copy->type = StatsMember::kBoolSequence;
+      copy->boolValues =
+          *member->cast_to<webrtc::RTCStatsMember<std::vector<bool> > >();
+      return true;
+
+    case webrtc::RTCStatsMemberInterface::kSequenceInt32:
+      CopyNumbers<int32_t>(member, copy);
+      return true;
+
+    case webrtc::RTCStatsMemberInterface::kSequenceUint32:
+      CopyNumbers<uint32_t>(member, copy);
+      return true;
+
+    case webrtc::RTCStatsMemberInterface::kSequenceInt64:
+      CopyNumbers<int64_t>(member, copy);
+      return true;
+
+    case webrtc::RTCStatsMemberInterface::kSequenceUint64:
+      CopyNumbers<uint64_t>(member, copy);
+      return true;
+
+    case webrtc::RTCStatsMemberInterface::kSequenceDouble:
+      CopyNumbers<double>(member, copy);
+      return true;
+
+    case webrtc::RTCStatsMemberInterface::kSequenceString:
+      copy->type = StatsMember::kStringSequence;
+      copy->stringValues = *member->cast_to<
+          webrtc::RTCStatsMember<std::vector<std::string> > >();
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+void CopyStats(const webrtc::RTCStatsReport &report,
+               std::vector<StatsEntry> *entries) {
+  entries->reserve(report.size());
+
+  for (const webrtc::RTCStats &stats : report) {
+    entries->push_back(StatsEntry());
+    StatsEntry &entry = entries->back();
+
+    entry.id = stats.id();
+    entry.type = stats.type();
+    entry.timestampUs = stats.timestamp_us();
+
+    std::vector<const webrtc::RTCStatsMemberInterface *> members =
+        stats.Members();
+    entry.members.reserve(members.size());
+
+    for (size_t i = 0; i < members.size(); i++) {
+      if (!members[i]->is_defined()) {
+        continue;
+      }
+
+      entry.members.push_back(StatsMember());
+
+      if (!CopyMember(members[i], &entry.members.back())) {
+        entry.members.pop_back();
+      }
+    }
+  }
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STATS_H_
+#define STATS_H_
+
+#include <webrtc/api/stats/rtcstatsreport.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Counters written by the compact getStats() mode, in this order. The
+// schema is exported as RTCPeerConnection.statsSchema.
+enum StatsField {
+  kStatsTimestamp,
+  kStatsCurrentRoundTripTime,
+  kStatsAvailableOutgoingBitrate,
+  kStatsBytesSent,
+  kStatsBytesReceived,
+  kStatsPacketsSent,
+  kStatsPacketsReceived,
+  kStatsPacketsLost,
+  kStatsJitter,
+  kStatsMessagesSent,
+  kStatsMessagesReceived,
+  kStatsFieldCount,
+};
+
+// The counters of a report, summed over its RTP streams and data channels.
+// The transport counters come from the nominated candidate pair.
+struct StatsSummary {
+  int64_t timestampUs;
+  double currentRoundTripTime;
+  double availableOutgoingBitrate;
+  uint64_t bytesSent;
+  uint64_t bytesReceived;
+  uint64_t packetsSent;
+  uint64_t packetsReceived;
+  uint64_t packetsLost;
+  double jitter;
+  uint64_t messagesSent;
+  uint64_t messagesReceived;
+
+  StatsSummary();
+
+  // Standard units: timestamp in milliseconds, times in seconds.
+  void WriteFloat64(double *values) const;
+
+  // Exact integers: timestamp and times in microseconds, bitrate in bits
+  // per second.
+  void WriteUint64(uint64_t *values) const;
+};
+
+// A plain copy of one RTCStats object, built on the signaling thread and
+// turned into a JavaScript object on the main thread.
+struct StatsMember {
+  enum Type {
+    kBool,
+    kNumber,
+    kString,
+    kBoolSequence,
+    kNumberSequence,
+    kStringSequence,
+  };
+
+  std::string name;
+  Type type;
+  bool boolValue;
+  double numberValue;
+  std::string stringValue;
+  std::vector<bool> boolValues;
+  std::vector<double> numberValues;
+  std::vector<std::string> stringValues;
+};
+
+struct StatsEntry {
+  std::string id;
+  std::string type;
+  int64_t timestampUs;
+  std::vector<StatsMember> members;
+};
+
+const char *GetStatsFieldName(StatsField field);
+
+// Returns false when the name is not part of the schema.
+bool GetStatsField(const char *name, StatsField *field);
+
+void SummarizeStats(const webrtc::RTCStatsReport &report,
+                    StatsSummary *summary);
+void CopyStats(const webrtc::RTCStatsReport &report,
+               std::vector<StatsEntry> *entries);
+
+#endif  // STATS_H_
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <webrtc/api/stats/rtcstatscollectorcallback.h>
+#include <cmath>
+#include "event/statsalertevent.h"
+#include "observer/peerconnectionobserver.h"
+#include "statssampler.h"
+
+static const uint32_t kDefaultHistory = 60;
+
+enum {
+  kSample,
+};
+
+static bool IsCounter(StatsField field) {
+  switch (field) {
+    case kStatsBytesSent:
+    case kStatsBytesReceived:
+    case kStatsPacketsSent:
+    case kStatsPacketsReceived:
+    case kStatsPacketsLost:
+    case kStatsMessagesSent:
+    case kStatsMessagesReceived:
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+class StatsSamplerCallback : public webrtc::RTCStatsCollectorCallback {
+ public:
+  static StatsSamplerCallback *Create(StatsHistory *history) {
+    return new rtc::RefCountedObject<StatsSamplerCallback>(history);
+  }
+
+  void OnStatsDelivered(
+      const rtc::scoped_refptr<const webrtc::RTCStatsReport> &report) {
+    StatsSummary summary;
+    SummarizeStats(*report, &summary);
+    _history->AddSample(summary);
+  }
+
+ protected:
+  explicit StatsSamplerCallback(StatsHistory *history)
+      : _history(history) {
+  }
+
+ private:
+  rtc::scoped_refptr<StatsHistory> _history;
+};
+
+StatsSamplerOptions::StatsSamplerOptions()
+    : period(0),
+      history(kDefaultHistory) {
+  for (int i = 0; i < kStatsFieldCount; ++i) {
+    fields.push_back(static_cast<StatsField>(i));
+  }
+}
+
+StatsHistory::StatsHistory(
+    const StatsSamplerOptions &options,
+    const rtc::scoped_refptr<webrtc::PeerConnectionInterface> &peerConnection,
+    PeerConnectionObserver *observer)
+    : _peerConnection(peerConnection),
+      _observer(observer),
+      _fields(options.fields),
+      _capacity(options.history),
+      _samples(options.history * options.fields.size()),
+      _next(0),
+      _count(0),
+      _hasPrevious(false) {
+  for (int i = 0; i < kStatsFieldCount; ++i) {
+    _previous[i] = 0;
+    _thresholds[i] = NAN;
+    _alerting[i] = false;
+  }
+}
+
+StatsHistory::~StatsHistory() {
+}
+
+StatsHistory *StatsHistory::Create(
+    const StatsSamplerOptions &options,
+    const rtc::scoped_refptr<webrtc::PeerConnectionInterface> &peerConnection,
+    PeerConnectionObserver *observer) {
+  return new rtc::RefCountedObject<StatsHistory>(options, peerConnection,
+                                                 observer);
+}
+
+webrtc::PeerConnectionInterface *StatsHistory::GetPeerConnection() const {
+  return _peerConnection.get();
+}
+
+const std::vector<StatsField> &StatsHistory::GetFields() const {
+  return _fields;
+}
+
+void StatsHistory::AddSample(const StatsSummary &summary) {
+  double values[kStatsFieldCount];
+  summary.WriteFloat64(values);
+
+  std::vector<StatsAlertEvent *> alerts;
+
+  {
+    rtc::CritScope lock(&_lock);
+    double *row = &_samples[_next * _fields.size()];
+
+    for (size_t i = 0; i < _fields.size(); ++i) {
+      row[i] = values[_fields[i]];
+    }
+
+    _next = (_next + 1) % _capacity;
+    _count = _count < _capacity ? _count + 1 : _capacity;
+
+    for (int i = 0; i < kStatsFieldCount; ++i) {
+      if (std::isnan(_thresholds[i])) {
+        continue;
+      }
+
+      StatsField field = static_cast<StatsField>(i);
+      double value = values[i];
+
+      if (IsCounter(field)) {
+        if (!_hasPrevious) {
+          continue;
+        }
+
+        value -= _previous[i];
+      }
+
+      if (value <= _thresholds[i]) {
+        _alerting[i] = false;
+      } else if (!_alerting[i]) {
+        _alerting[i] = true;
+        alerts.push_back(new StatsAlertEvent(_observer.get(), field, value,
+                                             _thresholds[i]));
+      }
+    }
+
+    for (int i = 0; i < kStatsFieldCount; ++i) {
+      _previous[i] = values[i];
+    }
+
+    _hasPrevious = true;
+  }
+
+  for (size_t i = 0; i < alerts.size(); ++i) {
+    _observer->GetEventQueue()->PushEvent(alerts[i]);
+  }
+}
+
+size_t StatsHistory::GetSamples(std::vector<double> *samples) {
+  rtc::CritScope lock(&_lock);
+  size_t first = (_next + _capacity - _count) % _capacity;
+
+  samples->reserve(_count * _fields.size());
+
+  for (size_t i = 0; i < _count; ++i) {
+    const double *row = &_samples[((first + i) % _capacity) * _fields.size()];
+    samples->insert(samples->end(), row, row + _fields.size());
+  }
+
+  return _count;
+}
+
+void StatsHistory::SetAlert(StatsField field, double threshold) {
+  rtc::CritScope lock(&_lock);
+  _thresholds[field] = threshold;
+  _alerting[field] = false;
+}
+
+void StatsHistory::ClearAlert(StatsField field) {
+  SetAlert(field, NAN);
+}
+
+StatsSampler::StatsSampler(rtc::Thread *signalingThread,
+                           const StatsSamplerOptions &options)
+    : _signalingThread(signalingThread),
+      _period(options.period) {
+}
+
+StatsSampler::~StatsSampler() {
+  _signalingThread->Clear(this, kSample);
+}
+
+void StatsSampler::Start() {
+  _signalingThread->PostDelayed(RTC_FROM_HERE, _period, this, kSample);
+}
+
+void StatsSampler::Add(StatsHistory *history) {
+  rtc::CritScope lock(&_lock);
+  _histories[history] = history;
+}
+
+void StatsSampler::Remove(StatsHistory *history) {
+  rtc::CritScope lock(&_lock);
+  _histories.erase(history);
+}
+
+void StatsSampler::OnMessage(rtc::Message *msg) {
+  std::vector<rtc::scoped_refptr<StatsHistory> > histories;
+
+  {
+    rtc::CritScope lock(&_lock);
+    histories.reserve(_histories.size());
+
+    for (std::map<StatsHistory *, rtc::scoped_refptr<StatsHistory> >::iterator
+             it = _histories.begin(); it != _histories.end(); ++it) {
+      histories.push_back(it->second);
+    }
+  }
+
+  // The collector gathers from the network and worker threads and calls
+  // back on this thread, the main thread is never involved.
+  for (size_t i = 0; i < histories.size(); ++i) {
+    histories[i]->GetPeerConnection()->GetStats(
+        StatsSamplerCallback::Create(histories[i]));
+  }
+
+  _signalingThread->PostDelayed(RTC_FROM_HERE, _period, this, kSample);
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STATSSAMPLER_H_
+#define STATSSAMPLER_H_
+
+#include <webrtc/api/peerconnectioninterface.h>
+#include <webrtc/base/criticalsection.h>
+#include <webrtc/base/messagehandler.h>
+#include <webrtc/base/thread.h>
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "stats.h"
+
+class PeerConnectionObserver;
+
+struct StatsSamplerOptions {
+  StatsSamplerOptions();
+
+  // Sampling period in milliseconds, zero disables the sampler.
+  uint32_t period;
+  // Number of samples kept per connection.
+  uint32_t history;
+  // The counters kept in each sample.
+  std::vector<StatsField> fields;
+};
+
+// The sampled time series of one connection, written on the signaling
+// thread and read from the main thread. It also holds the alert thresholds:
+// an alert fires when a value goes above its threshold, and again only after
+// it went back below. Cumulative counters are compared by their increase
+// over the last period, the other fields by their value.
+class StatsHistory : public rtc::RefCountInterface {
+ public:
+  static StatsHistory *Create(
+      const StatsSamplerOptions &options,
+      const rtc::scoped_refptr<webrtc::PeerConnectionInterface>
+          &peerConnection,
+      PeerConnectionObserver *observer);
+
+  webrtc::PeerConnectionInterface *GetPeerConnection() const;
+
+  void AddSample(const StatsSummary &summary);
+
+  // Copies the samples, oldest first, one row of GetFields().size() values
+  // per sample. Returns the number of samples.
+  size_t GetSamples(std::vector<double> *samples);
+  const std::vector<StatsField> &GetFields() const;
+
+  void SetAlert(StatsField field, double threshold);
+  void ClearAlert(StatsField field);
+
+ protected:
+  StatsHistory(const StatsSamplerOptions &options,
+               const rtc::scoped_refptr<webrtc::PeerConnectionInterface>
+                   &peerConnection,
+               PeerConnectionObserver *observer);
+  ~StatsHistory();
+
+ private:
+  const rtc::scoped_refptr<webrtc::PeerConnectionInterface> _peerConnection;
+  const rtc::scoped_refptr<PeerConnectionObserver> _observer;
+  const std::vector<StatsField> _fields;
+  const size_t _capacity;
+
+  rtc::CriticalSection _lock;
+  std::vector<double> _samples;
+  size_t _next;
+  size_t _count;
+
+  double _previous[kStatsFieldCount];
+  bool _hasPrevious;
+  double _thresholds[kStatsFieldCount];
+  bool _alerting[kStatsFieldCount];
+};
+
+// Samples the stats of every connection of a thread group, from its
+// signaling thread. It must be destroyed on that thread.
+class StatsSampler : public rtc::MessageHandler {
+ public:
+  StatsSampler(rtc::Thread *signalingThread,
+               const StatsSamplerOptions &options);
+  ~StatsSampler();
+
+  void Start();
+
+  void Add(StatsHistory *history);
+  void Remove(StatsHistory *history);
+
+  void OnMessage(rtc::Message *msg);
+
+ private:
+  rtc::Thread *_signalingThread;
+  const uint32_t _period;
+
+  rtc::CriticalSection _lock;
+  std::map<StatsHistory *, rtc::scoped_refptr<StatsHistory> > _histories;
+};
+
+#endif  // STATSSAMPLER_H_
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <uv.h>
+#include "stringtable.h"
+
+static const char *const kStrings[] = {
+  "binary",
+  "candidate",
+  "candidates",
+  "channel",
+  "data",
+  "endOfCandidates",
+  "field",
+  "id",
+  "offsets",
+  "sdp",
+  "threshold",
+  "timestamp",
+  "type",
+  "value",
+
+  "bufferedamountlow",
+  "close",
+  "datachannel",
+  "icecandidate",
+  "icecandidates",
+  "iceconnectionstatechange",
+  "icegatheringstatechange",
+  "message",
+  "messages",
+  "negotiationneeded",
+  "open",
+  "signalingstatechange",
+  "statsalert",
+
+  "onbufferedamountlow",
+  "onclose",
+  "ondatachannel",
+  "onicecandidate",
+  "onicecandidates",
+  "oniceconnectionstatechange",
+  "onicegatheringstatechange",
+  "onmessage",
+  "onmessages",
+  "onnegotiationneeded",
+  "onopen",
+  "onsignalingstatechange",
+  "onstatsalert",
+
+  "answer",
+  "offer",
+  "pranswer",
+  "rollback",
+
+  "new",
+  "checking",
+  "connected",
+  "completed",
+  "failed",
+  "disconnected",
+  "closed",
+  "gathering",
+  "complete",
+
+  "stable",
+  "have-local-offer",
+  "have-local-pranswer",
+  "have-remote-offer",
+  "have-remote-pranswer",
+
+  "connecting",
+  "closing",
+
+  "arraybuffer",
+  "nodebuffer",
+
+  "unknown",
+};
+
+static_assert(sizeof(kStrings) / sizeof(kStrings[0]) == kStringCount,
+              "kStrings and StringId are out of sync");
+
+struct Table {
+  Eternal<String> strings[kStringCount];
+};
+
+// Node runs each isolate on its own thread, the table is found through a
+// thread-local key. The Eternal handles themselves are released along with
+// their isolate.
+static uv_key_t sTableKey;
+static uv_once_t sTableKeyOnce = UV_ONCE_INIT;
+
+static void CreateTableKey() {
+  uv_key_create(&sTableKey);
+}
+
+void StringTable::Init() {
+  uv_once(&sTableKeyOnce, CreateTableKey);
+
+  if (uv_key_get(&sTableKey)) {
+    return;
+  }
+
+  Isolate *isolate = Isolate::GetCurrent();
+  Table *table = new Table();
+
+  for (size_t i = 0; i < kStringCount; ++i) {
+    table->strings[i].Set(isolate, String::NewFromUtf8(
+        isolate, kStrings[i], NewStringType::kInternalized).ToLocalChecked());
+  }
+
+  uv_key_set(&sTableKey, table);
+}
+
+void StringTable::Cleanup() {
+  delete static_cast<Table *>(uv_key_get(&sTableKey));
+  uv_key_set(&sTableKey, NULL);
+}
+
+Local<String> StringTable::Get(StringId id) {
+  Table *table = static_cast<Table *>(uv_key_get(&sTableKey));
+  return table->strings[id].Get(Isolate::GetCurrent());
+}
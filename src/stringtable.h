@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STRINGTABLE_H_
+#define STRINGTABLE_H_
+
+#include <nan.h>
+#include <cstddef>
+
+using namespace v8;
+
+// The dictionary keys, event names and enum values handed to JavaScript
+// over and over. StringTable::Get() returns them from a table of internalized
+// strings built once per isolate, so that hot getters and event payloads
+// never allocate them. Keep kStrings in stringtable.cc in the same order.
+enum StringId {
+  // Dictionary keys.
+  kStringBinary,
+  kStringCandidate,
+  kStringCandidates,
+  kStringChannel,
+  kStringData,
+  kStringEndOfCandidates,
+  kStringField,
+  kStringId,
+  kStringOffsets,
+  kStringSdp,
+  kStringThreshold,
+  kStringTimestamp,
+  kStringType,
+  kStringValue,
+
+  // Event types.
+  kStringBufferedAmountLow,
+  kStringClose,
+  kStringDataChannel,
+  kStringIceCandidate,
+  kStringIceCandidates,
+  kStringIceConnectionStateChange,
+  kStringIceGatheringStateChange,
+  kStringMessage,
+  kStringMessages,
+  kStringNegotiationNeeded,
+  kStringOpen,
+  kStringSignalingStateChange,
+  kStringStatsAlert,
+
+  // Event handlers.
+  kStringOnBufferedAmountLow,
+  kStringOnClose,
+  kStringOnDataChannel,
+  kStringOnIceCandidate,
+  kStringOnIceCandidates,
+  kStringOnIceConnectionStateChange,
+  kStringOnIceGatheringStateChange,
+  kStringOnMessage,
+  kStringOnMessages,
+  kStringOnNegotiationNeeded,
+  kStringOnOpen,
+  kStringOnSignalingStateChange,
+  kStringOnStatsAlert,
+
+  // RTCSdpType.
+  kStringAnswer,
+  kStringOffer,
+  kStringPranswer,
+  kStringRollback,
+
+  // RTCIceConnectionState and RTCIceGatheringState.
+  kStringNew,
+  kStringChecking,
+  kStringConnected,
+  kStringCompleted,
+  kStringFailed,
+  kStringDisconnected,
+  kStringClosed,
+  kStringGathering,
+  kStringComplete,
+
+  // RTCSignalingState.
+  kStringStable,
+  kStringHaveLocalOffer,
+  kStringHaveLocalPranswer,
+  kStringHaveRemoteOffer,
+  kStringHaveRemotePranswer,
+
+  // RTCDataChannelState, 'open' and 'closed' are above.
+  kStringConnecting,
+  kStringClosing,
+
+  // RTCDataChannel.binaryType.
+  kStringArrayBuffer,
+  kStringNodeBuffer,
+
+  kStringUnknown,
+
+  kStringCount
+};
+
+class StringTable {
+ public:
+  // Builds the table of the current isolate, from the module initializer.
+  static void Init();
+
+  // Forgets the table of the current isolate, from its cleanup.
+  static void Cleanup();
+
+  static Local<String> Get(StringId id);
+
+  // Maps a native enum value through a table indexed by that value, values
+  // past its end map to 'fallback'.
+  template <size_t N>
+  static Local<String> Get(const StringId (&table)[N], int value,
+                           StringId fallback) {
+    if (value < 0 || static_cast<size_t>(value) >= N) {
+      return Get(fallback);
+    }
+
+    return Get(table[value]);
+  }
+};
+
+#endif  // STRINGTABLE_H_
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "threadgroup.h"
+
+static const char kSignalingThreadName[] = "signaling_thread";
+static const char kWorkerThreadName[] = "worker_thread";
+static const char kNetworkThreadName[] = "network_thread";
+
+static const char kSignaling[] = "signaling";
+static const char kWorker[] = "worker";
+static const char kNetwork[] = "network";
+
+ThreadOptions::ThreadOptions()
+    : signalingThreadName(kSignalingThreadName),
+      workerThreadName(kWorkerThreadName),
+      networkThreadName(kNetworkThreadName),
+      dedicatedNetworkThread(true) {
+}
+
+ThreadGroup::ThreadGroup(size_t id, const ThreadOptions& options)
+    : _id(id),
+      _options(options),
+      _signalingThread(NULL),
+      _workerThread(NULL),
+      _networkThread(NULL),
+      _statsSampler(NULL),
+      _peerConnectionFactories(kMaxPeerConnectionFactories),
+      _connections(0),
+      _totalConnections(0) {
+}
+
+ThreadGroup::~ThreadGroup() {
+  if (_statsSampler) {
+    StatsSampler *statsSampler = _statsSampler;
+    _signalingThread->Invoke<void>(RTC_FROM_HERE, [statsSampler]() {
+      delete statsSampler;
+    });
+  }
+
+  _peerConnectionFactories.clear();
+
+  StopThreads();
+}
+
+void ThreadGroup::StopThreads() {
+  if (_networkThread && _networkThread != _workerThread) {
+    _networkThread->Stop();
+    delete _networkThread;
+  }
+
+  if (_signalingThread) {
+    _signalingThread->Stop();
+    delete _signalingThread;
+  }
+
+  if (_workerThread) {
+    _workerThread->Stop();
+    delete _workerThread;
+  }
+
+  _networkThread = NULL;
+  _signalingThread = NULL;
+  _workerThread = NULL;
+}
+
+bool ThreadGroup::Start() {
+  _signalingThread = rtc::Thread::Create().release();
+
+  // A worker thread which also carries the network must be able to poll
+  // sockets.
+  if (_options.dedicatedNetworkThread) {
+    _workerThread = rtc::Thread::Create().release();
+  } else {
+    _workerThread = rtc::Thread::CreateWithSocketServer().release();
+  }
+
+  _signalingThread->SetName(_options.signalingThreadName, NULL);
+  _workerThread->SetName(_options.workerThreadName, NULL);
+
+  if (_options.dedicatedNetworkThread) {
+    _networkThread = rtc::Thread::CreateWithSocketServer().release();
+    _networkThread->SetName(_options.networkThreadName, NULL);
+
+    if (!_networkThread->Start()) {
+      StopThreads();
+      return false;
+    }
+  } else {
+    _networkThread = _workerThread;
+  }
+
+  // The threads already running are stopped, the group is left as if it
+  // had never been started.
+  if (!_signalingThread->Start() ||
+      !_workerThread->Start()) {
+    StopThreads();
+    return false;
+  }
+
+  return true;
+}
+
+void ThreadGroup::StartStatsSampler(const StatsSamplerOptions &options) {
+  if (_statsSampler) {
+    return;
+  }
+
+  _statsSampler = new StatsSampler(_signalingThread, options);
+  _statsSampler->Start();
+}
+
+StatsSampler *ThreadGroup::GetStatsSampler() {
+  return _statsSampler;
+}
+
+size_t ThreadGroup::GetId() const {
+  return _id;
+}
+
+rtc::Thread *ThreadGroup::GetSignalingThread() {
+  return _signalingThread;
+}
+
+rtc::Thread *ThreadGroup::GetWorkerThread() {
+  return _workerThread;
+}
+
+rtc::Thread *ThreadGroup::GetNetworkThread() {
+  return _networkThread;
+}
+
+void ThreadGroup::GetThreads(std::vector<ThreadInfo> *threads) const {
+  ThreadInfo signaling = { _id, kSignaling, _signalingThread->name() };
+  ThreadInfo worker = { _id, kWorker, _workerThread->name() };
+  threads->push_back(signaling);
+  threads->push_back(worker);
+
+  if (_networkThread != _workerThread) {
+    ThreadInfo network = { _id, kNetwork, _networkThread->name() };
+    threads->push_back(network);
+  }
+}
+
+rtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface>
+    ThreadGroup::GetPeerConnectionFactory(size_t index) {
+  if (index >= _peerConnectionFactories.size()) {
+    return NULL;
+  }
+
+  rtc::CritScope lock(&_factoryLock);
+
+  if (!_peerConnectionFactories[index].get()) {
+    _peerConnectionFactories[index] = webrtc::CreatePeerConnectionFactory(
+        _networkThread, _workerThread, _signalingThread, NULL, NULL, NULL);
+  }
+
+  return _peerConnectionFactories[index];
+}
+
+void ThreadGroup::AddConnection() {
+  _connections.fetch_add(1);
+  _totalConnections.fetch_add(1);
+}
+
+void ThreadGroup::RemoveConnection() {
+  _connections.fetch_sub(1);
+}
+
+uint32_t ThreadGroup::GetConnectionCount() const {
+  return _connections.load();
+}
+
+uint64_t ThreadGroup::GetTotalConnectionCount() const {
+  return _totalConnections.load();
+}
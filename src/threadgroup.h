@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef THREADGROUP_H_
+#define THREADGROUP_H_
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <webrtc/api/peerconnectioninterface.h>
+#include <webrtc/base/criticalsection.h>
+#include <webrtc/base/thread.h>
+#include "statssampler.h"
+
+struct ThreadOptions {
+  ThreadOptions();
+
+  std::string signalingThreadName;
+  std::string workerThreadName;
+  std::string networkThreadName;
+
+  // When false, socket I/O runs on the worker thread.
+  bool dedicatedNetworkThread;
+};
+
+struct ThreadInfo {
+  size_t group;
+  std::string role;
+  std::string name;
+};
+
+// A signaling, worker and network thread triple, with the factories bound to
+// them. Connections are spread over several groups so a single process can
+// use more than a couple of cores.
+class ThreadGroup {
+ public:
+  ThreadGroup(size_t id, const ThreadOptions& options);
+  ~ThreadGroup();
+
+  bool Start();
+
+  size_t GetId() const;
+  rtc::Thread *GetSignalingThread();
+  rtc::Thread *GetWorkerThread();
+  rtc::Thread *GetNetworkThread();
+
+  // Starts sampling the stats of this group's connections. The sampler is
+  // NULL unless this has been called.
+  void StartStatsSampler(const StatsSamplerOptions &options);
+  StatsSampler *GetStatsSampler();
+  void GetThreads(std::vector<ThreadInfo> *threads) const;
+
+  // Returns the shared factory at the given pool index, creating it on first
+  // use. Must be called from the main thread.
+  rtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface>
+      GetPeerConnectionFactory(size_t index);
+
+  void AddConnection();
+  void RemoveConnection();
+  uint32_t GetConnectionCount() const;
+  uint64_t GetTotalConnectionCount() const;
+
+  static const size_t kMaxPeerConnectionFactories = 4;
+
+ private:
+  // Stops and deletes whichever threads were created.
+  void StopThreads();
+
+  const size_t _id;
+  ThreadOptions _options;
+  rtc::Thread *_signalingThread;
+  rtc::Thread *_workerThread;
+  rtc::Thread *_networkThread;
+  StatsSampler *_statsSampler;
+  // Factories are created on first use, possibly from several workers.
+  rtc::CriticalSection _factoryLock;
+  std::vector<rtc::scoped_refptr<
+      webrtc::PeerConnectionFactoryInterface> > _peerConnectionFactories;
+  std::atomic<uint32_t> _connections;
+  std::atomic<uint64_t> _totalConnections;
+};
+
+#endif  // THREADGROUP_H_
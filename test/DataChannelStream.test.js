@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+const assert = require('chai').assert;
+const DataChannelStream = require('../lib/DataChannelStream');
+
+// Stands in for a RTCDataChannel whose SCTP buffer only drains on demand.
+class FakeChannel {
+  constructor(readyState) {
+    this.readyState = readyState || 'open';
+    this.bufferedAmount = 0;
+    this.bufferedAmountLowThreshold = 0;
+    this.sent = [];
+  }
+
+  send(data) {
+    this.sent.push(data);
+    this.bufferedAmount += data.length;
+  }
+
+  close() {
+    this.readyState = 'closed';
+    this.onclose();
+  }
+
+  drain(amount) {
+    const previous = this.bufferedAmount;
+    this.bufferedAmount -= amount;
+
+    if (previous > this.bufferedAmountLowThreshold &&
+        this.bufferedAmount <= this.bufferedAmountLowThreshold) {
+      this.onbufferedamountlow();
+    }
+  }
+}
+
+describe('DataChannelStream', () => {
+  it('should configure the channel', () => {
+    const channel = new FakeChannel();
+    const stream = new DataChannelStream(channel, {
+      highWaterMark: 64,
+      lowWaterMark: 16
+    });
+
+    assert.strictEqual(stream.channel, channel);
+    assert.equal(channel.binaryType, 'nodebuffer');
+    assert.equal(channel.bufferedAmountLowThreshold, 16);
+  });
+
+  it('should return false at the high-water mark', () => {
+    const channel = new FakeChannel();
+    const stream = new DataChannelStream(channel, { highWaterMark: 64 });
+
+    assert.isTrue(stream.write(Buffer.alloc(32)));
+    assert.isFalse(stream.write(Buffer.alloc(32)));
+  });
+
+  it('should emit drain on bufferedamountlow', (done) => {
+    const channel = new FakeChannel();
+    const stream = new DataChannelStream(channel, {
+      highWaterMark: 64,
+      lowWaterMark: 16
+    });
+
+    assert.isFalse(stream.write(Buffer.alloc(64)));
+    assert.isFalse(stream.write(Buffer.alloc(8)));
+    assert.lengthOf(channel.sent, 1);
+
+    stream.once('drain', () => {
+      assert.lengthOf(channel.sent, 2);
+      done();
+    });
+
+    channel.drain(64);
+  });
+
+  it('should wait for the channel to open', () => {
+    const channel = new FakeChannel('connecting');
+    const stream = new DataChannelStream(channel);
+
+    stream.write(Buffer.from('hello'));
+    assert.lengthOf(channel.sent, 0);
+
+    channel.readyState = 'open';
+    channel.onopen();
+    assert.lengthOf(channel.sent, 1);
+  });
+
+  it('should push received messages as Buffers', (done) => {
+    const channel = new FakeChannel();
+    const stream = new DataChannelStream(channel);
+
+    stream.on('data', (data) => {
+      assert.instanceOf(data, Buffer);
+      assert.equal(data.toString(), 'hello');
+      done();
+    });
+
+    channel.onmessage({ type: 'message', data: 'hello' });
+  });
+
+  it('should close the channel when ended', (done) => {
+    const channel = new FakeChannel();
+    const stream = new DataChannelStream(channel);
+
+    stream.on('end', () => {
+      assert.equal(channel.readyState, 'closed');
+      done();
+    });
+
+    stream.resume();
+    stream.end();
+  });
+});
@@ -17,11 +17,20 @@
 'use strict';
 
 const chai = require('chai');
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
 const assert = chai.assert;
 const RTCCertificate = require('../').RTCCertificate;
 const RTCPeerConnection = require('../').RTCPeerConnection;
 
 describe('RTCCertificate', () => {
+  it('should not be constructible from JavaScript', () => {
+    assert.throw(() => {
+      new RTCCertificate();
+    }, TypeError, 'Illegal constructor');
+  });
+
   describe('generated using \'RSASSA-PKCS1-v1_5\' algorithm', () => {
     let certificate;
     const now = (+ new Date());
@@ -59,14 +68,32 @@ describe('RTCCertificate', () => {
       it('should be read-only', () => {
         const fingerprint = certificate.fingerprints[0];
 
-        certificate.fingerprints[0] = {
-          'algorithm': 'null',
-          'value': 'invalid'
-        };
+        assert.throw(() => {
+          certificate.fingerprints[0] = {
+            'algorithm': 'null',
+            'value': 'invalid'
+          };
+        }, TypeError);
 
+        assert.isFrozen(certificate.fingerprints);
+        assert.isFrozen(fingerprint);
         assert.deepEqual(certificate.fingerprints[0], fingerprint);
       });
 
+      it('should return the same array on every access', () => {
+        assert.strictEqual(certificate.fingerprints,
+          certificate.fingerprints);
+      });
+
+      it('should list the sha-256, sha-384, sha-512 and sha-1 ' +
+        'fingerprints', () => {
+        assert.deepEqual(certificate.fingerprints.map((f) => f.algorithm),
+          ['sha-256', 'sha-384', 'sha-512', 'sha-1']);
+        certificate.fingerprints.forEach((fingerprint) => {
+          assert.match(fingerprint.value, /^([0-9a-f]{2}:)+[0-9a-f]{2}$/);
+        });
+      });
+
       it('should be an array of objects having \'algorithm\' and \'value\' ' +
         'properties', () => {
         const fingerprint = certificate.fingerprints[0];
@@ -315,4 +342,50 @@ describe('RTCCertificate', () => {
       });
     });
   });
+
+  describe('store', () => {
+    const file = path.join(os.tmpdir(), 'webrtc-certificates-' +
+      process.pid + '.bin');
+    let certificates;
+
+    before(() => {
+      const ecdsa = { name: 'ECDSA', namedCurve: 'P-256' };
+
+      return Promise.all([
+        RTCPeerConnection.generateCertificate(ecdsa),
+        RTCPeerConnection.generateCertificate(ecdsa)
+      ]).then((result) => {
+        certificates = result;
+      });
+    });
+
+    after(() => {
+      if (fs.existsSync(file)) {
+        fs.unlinkSync(file);
+      }
+    });
+
+    it('should load the certificates it saved, in order', () => {
+      return RTCCertificate.save(file, certificates)
+        .then(() => RTCCertificate.load(file))
+        .then((loaded) => {
+          assert.lengthOf(loaded, certificates.length);
+          loaded.forEach((certificate, i) => {
+            assert.instanceOf(certificate, RTCCertificate);
+            assert.deepEqual(certificate.toPEM(), certificates[i].toPEM());
+            assert.equal(certificate.expires, certificates[i].expires);
+          });
+        });
+    });
+
+    it('should reject a file which is not a store', () => {
+      fs.writeFileSync(file, 'not a certificate store');
+
+      return RTCCertificate.load(file).then(() => {
+        assert.fail();
+      }, (error) => {
+        assert.equal(error.message, 'The certificate store is corrupted.');
+      });
+    });
+  });
 });
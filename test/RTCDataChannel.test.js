@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+const assert = require('chai').assert;
+const webrtc = require('../');
+const RTCDataChannel = webrtc.RTCDataChannel;
+const RTCPeerConnection = webrtc.RTCPeerConnection;
+
+describe('RTCDataChannel', () => {
+  describe('constructor', () => {
+    it('should throw a TypeError', () => {
+      assert.throw(() => {
+        new RTCDataChannel();
+      }, TypeError, 'Failed to construct \'RTCDataChannel\': ' +
+        'Illegal constructor');
+    });
+  });
+
+  describe('instance', () => {
+    const pc = new RTCPeerConnection();
+    const channel = pc.createDataChannel('data');
+
+    describe('binaryType property', () => {
+      it('should be set to \'arraybuffer\' by default', () => {
+        assert.equal(channel.binaryType, 'arraybuffer');
+      });
+
+      it('should accept \'nodebuffer\'', () => {
+        channel.binaryType = 'nodebuffer';
+        assert.equal(channel.binaryType, 'nodebuffer');
+        channel.binaryType = 'arraybuffer';
+      });
+
+      it('should ignore unknown values', () => {
+        channel.binaryType = 'blob';
+        assert.equal(channel.binaryType, 'arraybuffer');
+      });
+    });
+
+    describe('batchMessages property', () => {
+      it('should be disabled by default', () => {
+        assert.isFalse(channel.batchMessages);
+      });
+
+      it('should be settable', () => {
+        channel.batchMessages = true;
+        assert.isTrue(channel.batchMessages);
+        channel.batchMessages = false;
+      });
+    });
+
+    describe('batchMessages toggled while a batch is queued', function () {
+      this.timeout(10000);
+
+      // Keeps the event loop busy so that the received messages stay queued.
+      function spin(ms) {
+        const end = Date.now() + ms;
+        while (Date.now() < end);
+      }
+
+      function gather(pc) {
+        return new Promise((resolve) => {
+          const lines = [];
+          pc.onicecandidate = (event) => {
+            if (event.candidate) {
+              lines.push('a=' + event.candidate.candidate + '\r\n');
+            } else {
+              resolve(lines.join(''));
+            }
+          };
+        });
+      }
+
+      it('should deliver the messages in order', () => {
+        const offerer = new RTCPeerConnection();
+        const answerer = new RTCPeerConnection();
+        const sender = offerer.createDataChannel('batch');
+        const offererCandidates = gather(offerer);
+        const answererCandidates = gather(answerer);
+        const received = [];
+        let offer;
+        let answer;
+
+        const opened = new Promise((resolve) => {
+          sender.onopen = resolve;
+        });
+
+        const done = new Promise((resolve) => {
+          answerer.ondatachannel = (event) => {
+            const receiver = event.channel;
+            receiver.binaryType = 'nodebuffer';
+
+            receiver.onmessage = (message) => {
+              received.push(message.data.toString());
+
+              if (received.length === 3) {
+                resolve();
+              }
+            };
+
+            receiver.onmessages = (messages) => {
+              for (let i = 0; i < messages.offsets.length - 1; i++) {
+                received.push(messages.data.slice(messages.offsets[i],
+                  messages.offsets[i + 1]).toString());
+              }
+
+              if (received.length === 3) {
+                resolve();
+              }
+            };
+
+            opened.then(() => {
+              receiver.batchMessages = true;
+              sender.send('1');
+              spin(500);
+              receiver.batchMessages = false;
+              sender.send('2');
+              spin(500);
+              receiver.batchMessages = true;
+              sender.send('3');
+              spin(500);
+            });
+          };
+        });
+
+        return offerer.createOffer()
+          .then((desc) => {
+            offer = desc;
+            return offerer.setLocalDescription();
+          })
+          .then(() => offererCandidates)
+          .then((candidates) => answerer.setRemoteDescription({
+            type: 'offer', sdp: offer.sdp + candidates }))
+          .then(() => answerer.createAnswer())
+          .then((desc) => {
+            answer = desc;
+            return answerer.setLocalDescription();
+          })
+          .then(() => answererCandidates)
+          .then((candidates) => offerer.setRemoteDescription({
+            type: 'answer', sdp: answer.sdp + candidates }))
+          .then(() => done)
+          .then(() => assert.deepEqual(received, ['1', '2', '3']));
+      });
+    });
+
+    describe('send method', () => {
+      it('should throw an Error when not open', () => {
+        assert.throw(() => {
+          channel.send(Buffer.from('hello'));
+        }, Error, 'Failed to execute \'send\' on \'RTCDataChannel\': ' +
+          'RTCDataChannel.readyState is not \'open\'');
+      });
+    });
+  });
+});
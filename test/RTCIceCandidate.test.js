@@ -177,16 +177,12 @@ describe('RTCIceCandidate', () => {
       const iceCandidate = new RTCIceCandidate(dummyIceCandidate());
 
       it('should have the same value as passed in the constructor', () => {
-        assert.strictEqual(iceCandidate.foundation, 'candidate:123456789 1 udp ' +
-          '1234567891 ' + ipv6 + ' 12345 typ host ' +
-          'generation 0 ufrag ABCD network-id 4 network-cost 50');
+        assert.strictEqual(iceCandidate.foundation, '123456789');
       });
 
       it('should be read-only', () => {
         iceCandidate.foundation = 'empty foundation';
-        assert.strictEqual(iceCandidate.foundation, 'candidate:123456789 1 udp ' +
-          '1234567891 ' + ipv6 + ' 12345 typ host ' +
-          'generation 0 ufrag ABCD network-id 4 network-cost 50');
+        assert.strictEqual(iceCandidate.foundation, '123456789');
       });
     });
 
@@ -616,4 +612,65 @@ describe('RTCIceCandidate', () => {
       assert.strictEqual(Object.keys(iceCandidate).length, 3);
     });
   });
+
+  describe('parseMany', () => {
+    it('should resolve with the candidates, in order', () => {
+      return RTCIceCandidate.parseMany([
+        dummyIceCandidate(),
+        { candidate: newCandidate, sdpMLineIndex: 1 }
+      ]).then((candidates) => {
+        assert.lengthOf(candidates, 2);
+        candidates.forEach((candidate) => {
+          assert.instanceOf(candidate, RTCIceCandidate);
+        });
+
+        assert.strictEqual(candidates[0].candidate, udpFoundation);
+        assert.strictEqual(candidates[0].sdpMid, 'data');
+        assert.strictEqual(candidates[0].foundation, '123456789');
+        assert.strictEqual(candidates[1].candidate, newCandidate);
+        assert.isNull(candidates[1].sdpMid);
+        assert.strictEqual(candidates[1].sdpMLineIndex, 1);
+      });
+    });
+
+    it('should report invalid lines without failing the others', () => {
+      const invalid = 'candidate:123456789 1 sctp 1234567891 ' +
+        ipv6 + ' 12345 typ host generation 0 ufrag ABCD ' +
+        'network-id 4 network-cost 50';
+
+      return RTCIceCandidate.parseMany([
+        dummyIceCandidate(invalid),
+        dummyIceCandidate()
+      ]).then((candidates) => {
+        assert.instanceOf(candidates[0], Error);
+        assert.strictEqual(candidates[0].message,
+          errorPrefix + 'Unsupported transport type.');
+        assert.instanceOf(candidates[1], RTCIceCandidate);
+      });
+    });
+
+    it('should resolve with an empty array', () => {
+      return RTCIceCandidate.parseMany([]).then((candidates) => {
+        assert.deepEqual(candidates, []);
+      });
+    });
+
+    it('should reject if the argument is not an array', () => {
+      return RTCIceCandidate.parseMany(dummyIceCandidate()).then(() => {
+        assert.fail();
+      }, (error) => {
+        assert.instanceOf(error, TypeError);
+      });
+    });
+
+    it('should reject if both sdpMid and sdpMLineIndex are null', () => {
+      return RTCIceCandidate.parseMany([{ candidate: udpFoundation }])
+        .then(() => {
+          assert.fail();
+        }, (error) => {
+          assert.include(error.message,
+            'Both \'sdpMid\' and \'sdpMLineIndex\' properties are null.');
+        });
+    });
+  });
 });
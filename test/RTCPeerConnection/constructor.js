@@ -32,6 +32,123 @@ describe('new RTCPeerConnection', () => {
     });
   });
 
+  describe('called with a \'factory\' property', () => {
+    const errorPrefix = 'Failed to construct \'RTCPeerConnection\': ';
+
+    it('should accept a pooled factory index', () => {
+      assert.instanceOf(new RTCPeerConnection({ factory: 1 }),
+        RTCPeerConnection);
+    });
+
+    it('should throw a TypeError when not a number', () => {
+      assert.throw(() => {
+        new RTCPeerConnection({ factory: 'default' });
+      }, TypeError, errorPrefix + 'The \'factory\' property ' +
+        'is not a number.');
+    });
+
+    it('should throw a TypeError when not an integer', () => {
+      [NaN, 1.5].forEach((factory) => {
+        assert.throw(() => {
+          new RTCPeerConnection({ factory });
+        }, TypeError, errorPrefix + 'The \'factory\' property ' +
+          'is not an integer.');
+      });
+    });
+
+    it('should throw a RangeError when out of range', () => {
+      assert.throw(() => {
+        new RTCPeerConnection({ factory: 64 });
+      }, RangeError, errorPrefix + 'The \'factory\' property ' +
+        'is out of range.');
+    });
+  });
+
+  describe('called with a \'threadGroup\' property', () => {
+    const errorPrefix = 'Failed to construct \'RTCPeerConnection\': ';
+
+    it('should accept an existing thread group', () => {
+      assert.instanceOf(new RTCPeerConnection({ threadGroup: 0 }),
+        RTCPeerConnection);
+    });
+
+    it('should throw a TypeError when not an integer', () => {
+      [NaN, 0.7].forEach((threadGroup) => {
+        assert.throw(() => {
+          new RTCPeerConnection({ threadGroup });
+        }, TypeError, errorPrefix + 'The \'threadGroup\' property ' +
+          'is not an integer.');
+      });
+    });
+
+    it('should throw a RangeError for an unknown thread group', () => {
+      assert.throw(() => {
+        new RTCPeerConnection({ threadGroup: 1024 });
+      }, RangeError, errorPrefix + 'The \'threadGroup\' property ' +
+        'is out of range.');
+    });
+  });
+
+  describe('called with an \'iceCandidateBatchWindow\' property', () => {
+    const errorPrefix = 'Failed to construct \'RTCPeerConnection\': ';
+
+    it('should accept a window in milliseconds', () => {
+      assert.instanceOf(new RTCPeerConnection({ iceCandidateBatchWindow: 50 }),
+        RTCPeerConnection);
+    });
+
+    it('should throw a TypeError when not a number', () => {
+      assert.throw(() => {
+        new RTCPeerConnection({ iceCandidateBatchWindow: 'soon' });
+      }, TypeError, errorPrefix + 'The \'iceCandidateBatchWindow\' ' +
+        'property is not a number.');
+    });
+
+    it('should throw a TypeError when not an integer', () => {
+      [NaN, 0.5].forEach((iceCandidateBatchWindow) => {
+        assert.throw(() => {
+          new RTCPeerConnection({ iceCandidateBatchWindow });
+        }, TypeError, errorPrefix + 'The \'iceCandidateBatchWindow\' ' +
+          'property is not an integer.');
+      });
+    });
+
+    it('should throw a RangeError when out of range', () => {
+      assert.throw(() => {
+        new RTCPeerConnection({ iceCandidateBatchWindow: -1 });
+      }, RangeError, errorPrefix + 'The \'iceCandidateBatchWindow\' ' +
+        'property is out of range.');
+    });
+  });
+
+  describe('called with a \'certificates\' property', () => {
+    const errorPrefix = 'Failed to construct \'RTCPeerConnection\': ';
+    let certificate;
+
+    before(() => {
+      return RTCPeerConnection.generateCertificate({
+        name: 'ECDSA',
+        namedCurve: 'P-256'
+      }).then((cert) => {
+        certificate = cert;
+      });
+    });
+
+    it('should share a certificate between connections', () => {
+      assert.instanceOf(new RTCPeerConnection({ certificates: [certificate] }),
+        RTCPeerConnection);
+      assert.instanceOf(new RTCPeerConnection({ certificates: [certificate] }),
+        RTCPeerConnection);
+    });
+
+    it('should throw a TypeError when not an array of RTCCertificate', () => {
+      assert.throw(() => {
+        new RTCPeerConnection({ certificates: [{}] });
+      }, TypeError, errorPrefix + 'The \'certificates\' property is not ' +
+        'an array of RTCCertificate.');
+    });
+  });
+
   describe('instance', () => {
     const pc = new RTCPeerConnection();
 
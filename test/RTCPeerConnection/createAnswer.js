@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+const chai = require('chai');
+const assert = chai.assert;
+const chaiAsPromised = require("chai-as-promised");
+const RTCPeerConnection = require('../../').RTCPeerConnection;
+
+chai.use(chaiAsPromised);
+
+describe('RTCPeerConnection#createAnswer', () => {
+  const errorPrefix = 'Failed to execute \'createAnswer\' on ' +
+    '\'RTCPeerConnection\': ';
+
+  function withRemoteOffer() {
+    const offerer = new RTCPeerConnection();
+    const answerer = new RTCPeerConnection();
+
+    offerer.createDataChannel('test');
+
+    return offerer.createOffer()
+      .then((offer) => answerer.setRemoteDescription(offer))
+      .then(() => answerer);
+  }
+
+  describe('called without a remote offer', () => {
+    it('should reject with an Error', () => {
+      return assert.isRejected(new RTCPeerConnection().createAnswer(), Error);
+    });
+  });
+
+  describe('called with no parameters', () => {
+    it('should resolve with an answer', () => {
+      return withRemoteOffer()
+        .then((pc) => pc.createAnswer())
+        .then((desc) => {
+          assert.equal(desc.type, 'answer');
+          assert.typeOf(desc.sdp, 'string');
+        });
+    });
+  });
+
+  describe('called with one parameter', () => {
+    describe('not being an Object', () => {
+      it('should reject with a TypeError', () => {
+        return assert.isRejected(
+          new RTCPeerConnection().createAnswer(1.25),
+          TypeError, errorPrefix + 'parameter 1 (\'options\') ' +
+          'is not an object.');
+      });
+    });
+  });
+
+  describe('called with two parameters', () => {
+    describe('second one not being a Function', () => {
+      it('should throw a TypeError', () => {
+        assert.throw(() => {
+          new RTCPeerConnection().createAnswer(() => {}, undefined);
+        }, TypeError, errorPrefix + 'parameter 2 (\'failureCallback\') ' +
+          'is not a function.');
+      });
+    });
+
+    describe('both being functions', () => {
+      it('should call the first callback with an answer', (done) => {
+        withRemoteOffer().then((pc) => {
+          pc.createAnswer((desc) => {
+            assert.equal(desc.type, 'answer');
+            done();
+          }, done);
+        });
+      });
+    });
+  });
+});
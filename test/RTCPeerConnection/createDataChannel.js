@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+const assert = require('chai').assert;
+const webrtc = require('../../');
+const RTCDataChannel = webrtc.RTCDataChannel;
+const RTCPeerConnection = webrtc.RTCPeerConnection;
+
+describe('RTCPeerConnection#createDataChannel', () => {
+  const errorPrefix = 'Failed to execute \'createDataChannel\' on ' +
+    '\'RTCPeerConnection\': ';
+  const pc = new RTCPeerConnection();
+
+  describe('called with no parameters', () => {
+    it('should throw an Error', () => {
+      assert.throw(() => {
+        pc.createDataChannel();
+      }, Error, errorPrefix + '1 argument required, but only 0 present.');
+    });
+  });
+
+  describe('called with a label', () => {
+    const channel = pc.createDataChannel('chat');
+
+    it('should return a RTCDataChannel', () => {
+      assert.instanceOf(channel, RTCDataChannel);
+    });
+
+    it('should apply the default options', () => {
+      assert.equal(channel.label, 'chat');
+      assert.isTrue(channel.ordered);
+      assert.isNull(channel.maxPacketLifeTime);
+      assert.isNull(channel.maxRetransmits);
+      assert.equal(channel.protocol, '');
+      assert.isFalse(channel.negotiated);
+      assert.equal(channel.readyState, 'connecting');
+    });
+  });
+
+  describe('called with a dataChannelDict', () => {
+    it('should apply the options', () => {
+      const channel = pc.createDataChannel('game', {
+        ordered: false,
+        maxRetransmits: 0,
+        protocol: 'state',
+        negotiated: true,
+        id: 42
+      });
+
+      assert.isFalse(channel.ordered);
+      assert.equal(channel.maxRetransmits, 0);
+      assert.equal(channel.protocol, 'state');
+      assert.isTrue(channel.negotiated);
+      assert.equal(channel.id, 42);
+    });
+
+    it('should throw a TypeError when not an object', () => {
+      assert.throw(() => {
+        pc.createDataChannel('chat', 1);
+      }, TypeError, errorPrefix + 'parameter 2 (\'dataChannelDict\') is ' +
+        'not an object.');
+    });
+
+    it('should throw a TypeError with both retransmission limits', () => {
+      assert.throw(() => {
+        pc.createDataChannel('chat', {
+          maxPacketLifeTime: 100,
+          maxRetransmits: 3
+        });
+      }, TypeError, errorPrefix + 'The \'maxPacketLifeTime\' and ' +
+        '\'maxRetransmits\' properties cannot both be set.');
+    });
+
+    it('should throw a TypeError when negotiated without an id', () => {
+      assert.throw(() => {
+        pc.createDataChannel('chat', { negotiated: true });
+      }, TypeError, errorPrefix + 'The \'id\' property is required when ' +
+        '\'negotiated\' is true.');
+    });
+
+    it('should throw a TypeError when the id is out of range', () => {
+      assert.throw(() => {
+        pc.createDataChannel('chat', { negotiated: true, id: 65535 });
+      }, TypeError, errorPrefix + 'The \'id\' property is out of range.');
+    });
+  });
+});
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+const assert = require('chai').assert;
+const RTCPeerConnection = require('../../').RTCPeerConnection;
+
+describe('RTCPeerConnection events', () => {
+  describe('before any negotiation', () => {
+    const pc = new RTCPeerConnection();
+
+    it('should be in the stable signaling state', () => {
+      assert.equal(pc.signalingState, 'stable');
+    });
+
+    it('should not have gathered any candidate', () => {
+      assert.equal(pc.iceGatheringState, 'new');
+    });
+
+    it('should not have any ICE connection', () => {
+      assert.equal(pc.iceConnectionState, 'new');
+    });
+  });
+
+  describe('the event handlers', () => {
+    const handlers = [
+      'ondatachannel',
+      'onicecandidate',
+      'onicecandidates',
+      'oniceconnectionstatechange',
+      'onicegatheringstatechange',
+      'onnegotiationneeded',
+      'onsignalingstatechange'
+    ];
+
+    handlers.forEach((handler) => {
+      it(`should accept a function as ${handler}`, () => {
+        const pc = new RTCPeerConnection();
+        const callback = () => {};
+
+        assert.isUndefined(pc[handler]);
+        pc[handler] = callback;
+        assert.strictEqual(pc[handler], callback);
+      });
+    });
+  });
+});
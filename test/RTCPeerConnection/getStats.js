@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+const chai = require('chai');
+const assert = chai.assert;
+const chaiAsPromised = require('chai-as-promised');
+const RTCPeerConnection = require('../../').RTCPeerConnection;
+
+chai.use(chaiAsPromised);
+
+describe('RTCPeerConnection#getStats', () => {
+  const errorPrefix = 'Failed to execute \'getStats\' on ' +
+    '\'RTCPeerConnection\': ';
+  const pc = new RTCPeerConnection();
+  const schema = RTCPeerConnection.statsSchema;
+
+  describe('statsSchema', () => {
+    it('should list the compact counters', () => {
+      assert.isArray(schema);
+      assert.equal(schema[0], 'timestamp');
+      assert.include(schema, 'currentRoundTripTime');
+      assert.include(schema, 'bytesSent');
+      assert.include(schema, 'jitter');
+    });
+  });
+
+  describe('called with no parameters', () => {
+    it('should resolve with a report', () => {
+      return pc.getStats().then((report) => {
+        assert.instanceOf(report, Map);
+        report.forEach((stats, id) => {
+          assert.equal(stats.id, id);
+          assert.typeOf(stats.type, 'string');
+          assert.typeOf(stats.timestamp, 'number');
+        });
+      });
+    });
+  });
+
+  describe('called with a Float64Array', () => {
+    it('should fill it in place', () => {
+      const array = new Float64Array(schema.length * 2);
+
+      return pc.getStats(array, schema.length).then((result) => {
+        assert.strictEqual(result, array);
+        assert.equal(array[0], 0);
+        assert.isAbove(array[schema.length], 0);
+      });
+    });
+
+    it('should reject a too small array', () => {
+      return assert.isRejected(pc.getStats(new Float64Array(1)), RangeError,
+        errorPrefix + 'The array is too small to hold the stats at the ' +
+        'given offset.');
+    });
+
+    it('should reject a non-integer offset', () => {
+      const array = new Float64Array(schema.length * 2);
+
+      return Promise.all([NaN, 1.9].map((offset) => assert.isRejected(
+        pc.getStats(array, offset), TypeError,
+        errorPrefix + 'parameter 2 (\'offset\') is not an integer.')));
+    });
+
+    it('should reject an out of range offset', () => {
+      return assert.isRejected(
+        pc.getStats(new Float64Array(schema.length), 1), RangeError,
+        errorPrefix + 'The array is too small to hold the stats at the ' +
+        'given offset.');
+    });
+  });
+
+  describe('called with another object', () => {
+    it('should reject with a TypeError', () => {
+      return assert.isRejected(pc.getStats(new Uint8Array(64)), TypeError,
+        errorPrefix + 'parameter 1 (\'array\') is not a Float64Array or a ' +
+        'BigUint64Array.');
+    });
+  });
+});
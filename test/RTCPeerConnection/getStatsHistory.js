@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+const chai = require('chai');
+const assert = chai.assert;
+const RTCPeerConnection = require('../../').RTCPeerConnection;
+
+describe('RTCPeerConnection#getStatsHistory', () => {
+  const pc = new RTCPeerConnection();
+
+  it('should return whole rows of samples', () => {
+    const history = pc.getStatsHistory();
+
+    assert.instanceOf(history, Float64Array);
+    assert.equal(history.length % RTCPeerConnection.statsSchema.length, 0);
+  });
+});
+
+describe('RTCPeerConnection#setStatsAlert', () => {
+  const errorPrefix = 'Failed to execute \'setStatsAlert\' on ' +
+    '\'RTCPeerConnection\': ';
+  const pc = new RTCPeerConnection();
+
+  it('should throw a TypeError for an unknown field', () => {
+    assert.throw(() => {
+      pc.setStatsAlert('rtt', 0.5);
+    }, TypeError, errorPrefix + 'The provided value \'rtt\' is not a valid ' +
+      'stats field.');
+  });
+
+  it('should throw a TypeError when the threshold is not a number', () => {
+    assert.throw(() => {
+      pc.setStatsAlert('packetsLost', '10');
+    }, TypeError, errorPrefix + 'parameter 2 (\'threshold\') is not a ' +
+      'number or null.');
+  });
+});
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+const chai = require('chai');
+const assert = chai.assert;
+const chaiAsPromised = require("chai-as-promised");
+const RTCPeerConnection = require('../../').RTCPeerConnection;
+
+chai.use(chaiAsPromised);
+
+describe('RTCPeerConnection#setLocalDescription', () => {
+  const errorPrefix = 'Failed to execute \'setLocalDescription\' on ' +
+    '\'RTCPeerConnection\': ';
+
+  function createConnection() {
+    const pc = new RTCPeerConnection();
+    pc.createDataChannel('test');
+    return pc;
+  }
+
+  describe('called with an offer', () => {
+    it('should resolve and move to have-local-offer', () => {
+      const pc = createConnection();
+
+      return pc.createOffer()
+        .then((offer) => pc.setLocalDescription(offer))
+        .then((result) => {
+          assert.isUndefined(result);
+          assert.equal(pc.signalingState, 'have-local-offer');
+        });
+    });
+  });
+
+  describe('chained right after createOffer', () => {
+    it('should run both in order', () => {
+      const pc = createConnection();
+      const order = [];
+
+      return Promise.all([
+        pc.createOffer().then(() => order.push('createOffer')),
+        pc.setLocalDescription().then(() => order.push('setLocalDescription'))
+      ]).then(() => {
+        assert.deepEqual(order, ['createOffer', 'setLocalDescription']);
+        assert.equal(pc.signalingState, 'have-local-offer');
+      });
+    });
+  });
+
+  describe('called with no description and no offer created', () => {
+    it('should create and set an offer', () => {
+      const pc = createConnection();
+
+      return pc.setLocalDescription()
+        .then(() => assert.equal(pc.signalingState, 'have-local-offer'));
+    });
+  });
+
+  describe('called with a description which is not an Object', () => {
+    it('should reject with a TypeError', () => {
+      return assert.isRejected(
+        createConnection().setLocalDescription(12),
+        TypeError, errorPrefix + 'parameter 1 (\'descriptionInitDict\') ' +
+        'is not an object.');
+    });
+  });
+
+  describe('called with an invalid SDP', () => {
+    it('should reject with an Error', () => {
+      return assert.isRejected(
+        createConnection().setLocalDescription({ type: 'offer', sdp: 'x' }),
+        Error);
+    });
+  });
+
+  describe('called with callbacks', () => {
+    it('should throw a TypeError when the failure callback is missing', () => {
+      assert.throw(() => {
+        createConnection().setLocalDescription({ type: 'offer', sdp: '' },
+                                               () => {});
+      }, TypeError, errorPrefix + 'parameter 3 (\'failureCallback\') ' +
+        'is not a function.');
+    });
+
+    it('should call the success callback', (done) => {
+      const pc = createConnection();
+
+      pc.createOffer((offer) => {
+        pc.setLocalDescription(offer, () => done(), done);
+      }, done);
+    });
+  });
+});
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+const chai = require('chai');
+const assert = chai.assert;
+const chaiAsPromised = require("chai-as-promised");
+const RTCPeerConnection = require('../../').RTCPeerConnection;
+
+chai.use(chaiAsPromised);
+
+describe('RTCPeerConnection#setRemoteDescription', () => {
+  const errorPrefix = 'Failed to execute \'setRemoteDescription\' on ' +
+    '\'RTCPeerConnection\': ';
+
+  describe('called with an offer', () => {
+    it('should resolve and move to have-remote-offer', () => {
+      const offerer = new RTCPeerConnection();
+      const answerer = new RTCPeerConnection();
+
+      offerer.createDataChannel('test');
+
+      return offerer.createOffer()
+        .then((offer) => answerer.setRemoteDescription(offer))
+        .then(() => assert.equal(answerer.signalingState,
+                                 'have-remote-offer'));
+    });
+  });
+
+  describe('called with no parameters', () => {
+    it('should reject with a TypeError', () => {
+      return assert.isRejected(
+        new RTCPeerConnection().setRemoteDescription(),
+        TypeError, errorPrefix + 'parameter 1 (\'descriptionInitDict\') ' +
+        'is not an object.');
+    });
+  });
+
+  describe('called with an unknown type', () => {
+    it('should reject with a TypeError', () => {
+      return assert.isRejected(
+        new RTCPeerConnection().setRemoteDescription({ type: 'foo', sdp: '' }),
+        TypeError, errorPrefix + 'The provided value \'foo\' is not a valid ' +
+        'enum value of type RTCSdpType.');
+    });
+  });
+
+  describe('called with an answer', () => {
+    it('should bring both connections back to stable', () => {
+      const offerer = new RTCPeerConnection();
+      const answerer = new RTCPeerConnection();
+
+      offerer.createDataChannel('test');
+
+      return offerer.createOffer()
+        .then((offer) => Promise.all([
+          offerer.setLocalDescription(offer),
+          answerer.setRemoteDescription(offer),
+          answerer.createAnswer()
+        ]))
+        .then((results) => Promise.all([
+          answerer.setLocalDescription(results[2]),
+          offerer.setRemoteDescription(results[2])
+        ]))
+        .then(() => {
+          assert.equal(offerer.signalingState, 'stable');
+          assert.equal(answerer.signalingState, 'stable');
+        });
+    });
+  });
+});
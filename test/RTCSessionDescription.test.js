@@ -166,4 +166,60 @@ describe('RTCSessionDescription', () => {
     assert.strictEqual(sessionDescription.type, sdp.type);
     assert.strictEqual(sessionDescription.sdp, sdp.sdp);
   });
+
+  it('should return the same strings on every access', () => {
+    const sessionDescription = new RTCSessionDescription(sdp);
+
+    assert.strictEqual(sessionDescription.sdp, sessionDescription.sdp);
+    assert.strictEqual(sessionDescription.type, 'offer');
+  });
+
+  it('should keep the SDP it was given, non-ASCII characters included',
+    () => {
+      const init = {
+        type: 'offer',
+        sdp: sdp.sdp.replace('s=-', 's=caf\u00e9 \u{1f600}')
+      };
+
+      assert.strictEqual(new RTCSessionDescription(init).sdp, init.sdp);
+    }
+  );
+
+  describe('parse', () => {
+    const parsePrefix = 'Failed to execute \'parse\' on ' +
+      '\'RTCSessionDescription\': ';
+
+    it('should resolve with an RTCSessionDescription', () => {
+      return RTCSessionDescription.parse(sdp).then((sessionDescription) => {
+        assert.instanceOf(sessionDescription, RTCSessionDescription);
+        assert.strictEqual(sessionDescription.type, sdp.type);
+        assert.strictEqual(sessionDescription.sdp, sdp.sdp);
+      });
+    });
+
+    it('should reject with a TypeError on an invalid dictionary', () => {
+      return RTCSessionDescription.parse({type: 'anything', sdp: sdp.sdp})
+        .then(() => {
+          assert.fail();
+        }, (error) => {
+          assert.instanceOf(error, TypeError);
+          assert.strictEqual(error.message, parsePrefix + 'The provided ' +
+            'value \'anything\' is not a valid enum value of type ' +
+            'RTCSdpType.');
+        });
+    });
+
+    it('should reject with a TypeError on an invalid \'sdp\' property',
+      () => {
+        return RTCSessionDescription.parse({type: 'offer', sdp: 'v=0\r\n'})
+          .then(() => {
+            assert.fail();
+          }, (error) => {
+            assert.instanceOf(error, TypeError);
+            assert.strictEqual(error.message,
+              parsePrefix + 'Expect line: o=');
+          });
+      }
+    );
+  });
 });
@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2017 Axel Isouard <axel@isouard.fr>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+const chai = require('chai');
+const assert = chai.assert;
+const childProcess = require('child_process');
+const path = require('path');
+const webrtc = require('../');
+
+let workerThreads = null;
+
+try {
+  workerThreads = require('worker_threads');
+} catch (err) {
+  // Not available before Node 10.5, or without --experimental-worker.
+}
+
+describe('webrtc', () => {
+  const errorPrefix = 'Failed to execute \'configure\' on \'webrtc\': ';
+
+  describe('configure', () => {
+    it('should throw a TypeError when called without an Object', () => {
+      assert.throw(() => {
+        webrtc.configure(1);
+      }, TypeError, errorPrefix + 'parameter 1 (\'options\') ' +
+        'is not an object.');
+    });
+
+    it('should throw a TypeError when a thread name is not a string', () => {
+      assert.throw(() => {
+        webrtc.configure({ threads: { worker: 12 } });
+      }, TypeError, errorPrefix + 'The \'worker\' property ' +
+        'is not a string, or is empty.');
+    });
+
+    it('should throw a RangeError when threadGroups is out of range', () => {
+      assert.throw(() => {
+        webrtc.configure({ threadGroups: 0 });
+      }, RangeError, errorPrefix + 'The \'threadGroups\' property ' +
+        'is out of range.');
+    });
+
+    it('should throw a TypeError when threadGroups is not an integer',
+      () => {
+        [NaN, 1.5].forEach((threadGroups) => {
+          assert.throw(() => {
+            webrtc.configure({ threadGroups });
+          }, TypeError, errorPrefix + 'The \'threadGroups\' property ' +
+            'is not an integer.');
+        });
+      });
+
+    it('should throw a TypeError for an unknown placement policy', () => {
+      assert.throw(() => {
+        webrtc.configure({ placement: 'random' });
+      }, TypeError, errorPrefix + 'The provided value \'random\' is not ' +
+        'a valid placement policy.');
+    });
+
+    it('should throw a RangeError when the stats period is out of range',
+      () => {
+        assert.throw(() => {
+          webrtc.configure({ stats: { period: -1 } });
+        }, RangeError, errorPrefix + 'The \'period\' property ' +
+          'is out of range.');
+      });
+
+    it('should throw a TypeError when the stats options are not integers',
+      () => {
+        assert.throw(() => {
+          webrtc.configure({ stats: { period: 0.5 } });
+        }, TypeError, errorPrefix + 'The \'period\' property ' +
+          'is not an integer.');
+
+        assert.throw(() => {
+          webrtc.configure({ stats: { history: 1.9 } });
+        }, TypeError, errorPrefix + 'The \'history\' property ' +
+          'is not an integer.');
+      });
+
+    it('should throw a TypeError for an unknown stats field', () => {
+      assert.throw(() => {
+        webrtc.configure({ stats: { period: 1000, fields: ['rtt'] } });
+      }, TypeError, errorPrefix + 'The \'fields\' property is not an ' +
+        'array of RTCPeerConnection.statsSchema names, or is empty.');
+    });
+
+    it('should throw a RangeError when a certificate pool size is out of ' +
+      'range', () => {
+      assert.throw(() => {
+        webrtc.configure({ certificatePool: { rsa: 100000 } });
+      }, RangeError, errorPrefix + 'The \'rsa\' property ' +
+        'is out of range.');
+    });
+
+    it('should throw a TypeError when a certificate pool size is not an ' +
+      'integer', () => {
+      assert.throw(() => {
+        webrtc.configure({ certificatePool: { ecdsa: 2.5 } });
+      }, TypeError, errorPrefix + 'The \'ecdsa\' property ' +
+        'is not an integer.');
+    });
+
+    it('should throw once the threads are running', () => {
+      new webrtc.RTCPeerConnection();
+
+      assert.throw(() => {
+        webrtc.configure({ threads: { network: null } });
+      }, Error, errorPrefix + 'The WebRTC threads are already running');
+    });
+  });
+
+  describe('with the network thread shared with the worker', function () {
+    this.timeout(20000);
+
+    // The threads are configured once per process, the connection runs in a
+    // child process of its own.
+    const source = `
+      const webrtc = require(${JSON.stringify(path.join(__dirname, '..'))});
+      webrtc.configure({ threads: { network: null } });
+
+      const offerer = new webrtc.RTCPeerConnection();
+      const answerer = new webrtc.RTCPeerConnection();
+      const channel = offerer.createDataChannel('test');
+
+      function gather(pc) {
+        return new Promise((resolve) => {
+          const lines = [];
+          pc.onicecandidate = (event) => {
+            if (event.candidate) {
+              lines.push('a=' + event.candidate.candidate + '\\r\\n');
+            } else {
+              resolve(lines.join(''));
+            }
+          };
+        });
+      }
+
+      const offererCandidates = gather(offerer);
+      const answererCandidates = gather(answerer);
+      let offer;
+      let answer;
+
+      answerer.ondatachannel = (event) => {
+        event.channel.onmessage = (message) => {
+          process.stdout.write(message.data);
+          process.exit(0);
+        };
+      };
+
+      channel.onopen = () => channel.send('connected');
+
+      offerer.createOffer()
+        .then((desc) => { offer = desc; return offerer.setLocalDescription(); })
+        .then(() => offererCandidates)
+        .then((candidates) => answerer.setRemoteDescription({
+          type: 'offer', sdp: offer.sdp + candidates }))
+        .then(() => answerer.createAnswer())
+        .then((desc) => { answer = desc; return answerer.setLocalDescription(); })
+        .then(() => answererCandidates)
+        .then((candidates) => offerer.setRemoteDescription({
+          type: 'answer', sdp: answer.sdp + candidates }))
+        .catch((err) => { console.error(err); process.exit(1); });
+    `;
+
+    it('should connect a data channel', () => {
+      const result = childProcess.spawnSync(process.execPath, ['-e', source], {
+        encoding: 'utf8',
+        timeout: 15000
+      });
+
+      assert.equal(result.status, 0, result.stderr);
+      assert.equal(result.stdout, 'connected');
+    });
+  });
+
+  describe('getThreads', () => {
+    it('should list the signaling, worker and network threads', () => {
+      new webrtc.RTCPeerConnection();
+
+      const threads = webrtc.getThreads();
+      assert.sameMembers(threads.map((thread) => thread.role),
+        ['signaling', 'worker', 'network']);
+      threads.forEach((thread) => {
+        assert.typeOf(thread.name, 'string');
+        assert.equal(thread.group, 0);
+      });
+    });
+  });
+
+  describe('getThreadGroups', () => {
+    it('should count the connections placed on each group', () => {
+      const before = webrtc.getThreadGroups()[0].totalConnections;
+      new webrtc.RTCPeerConnection({ threadGroup: 0 });
+
+      const groups = webrtc.getThreadGroups();
+      assert.lengthOf(groups, 1);
+      assert.equal(groups[0].id, 0);
+      assert.equal(groups[0].totalConnections, before + 1);
+      assert.isAbove(groups[0].connections, 0);
+      assert.isNotEmpty(groups[0].threads);
+    });
+  });
+
+  describe('getCertificatePoolStats', () => {
+    it('should return the certificate pool counters', () => {
+      const stats = webrtc.getCertificatePoolStats();
+
+      assert.typeOf(stats.hits, 'number');
+      assert.typeOf(stats.misses, 'number');
+      assert.typeOf(stats.ecdsa, 'number');
+      assert.typeOf(stats.rsa, 'number');
+    });
+  });
+
+  describe('getEventPoolStats', () => {
+    it('should return the event allocation counters', () => {
+      const stats = webrtc.getEventPoolStats();
+
+      assert.typeOf(stats.heapAllocations, 'number');
+      assert.typeOf(stats.pooledAllocations, 'number');
+      assert.typeOf(stats.releases, 'number');
+      assert.typeOf(stats.remoteReleases, 'number');
+    });
+
+    it('should not allocate events in the steady state', () => {
+      const pc = new webrtc.RTCPeerConnection();
+      const count = 10;
+      let before;
+
+      function createOffers(remaining) {
+        return remaining ? pc.createOffer().then(() =>
+          createOffers(remaining - 1)) : Promise.resolve();
+      }
+
+      // The counters are process-wide, they are compared once the pool
+      // holds an event released by this connection.
+      return pc.createOffer()
+        .then(() => {
+          before = webrtc.getEventPoolStats();
+          return createOffers(count);
+        })
+        .then(() => {
+          const after = webrtc.getEventPoolStats();
+
+          assert.equal(after.heapAllocations, before.heapAllocations);
+          assert.isAtLeast(after.pooledAllocations,
+            before.pooledAllocations + count);
+        });
+    });
+  });
+
+  describe('setLogLevel', () => {
+    const prefix = 'Failed to execute \'setLogLevel\' on \'webrtc\': ';
+
+    after(() => webrtc.setLogLevel('peerconnection', 'none'));
+
+    it('should update the level of a category', () => {
+      webrtc.setLogLevel('peerconnection', 'warning');
+      assert.equal(webrtc.getLogStats().levels.peerconnection, 'warning');
+    });
+
+    it('should throw a TypeError for an unknown category', () => {
+      assert.throw(() => {
+        webrtc.setLogLevel('media', 'info');
+      }, TypeError, prefix + 'The provided value \'media\' is not a valid ' +
+        'log category.');
+    });
+
+    it('should throw a TypeError for an unknown level', () => {
+      assert.throw(() => {
+        webrtc.setLogLevel('peerconnection', 'debug');
+      }, TypeError, prefix + 'The provided value \'debug\' is not a valid ' +
+        'log level.');
+    });
+  });
+
+  describe('setLogSink', () => {
+    it('should throw a TypeError for an unknown sink', () => {
+      assert.throw(() => {
+        webrtc.setLogSink('syslog');
+      }, TypeError, 'The provided value \'syslog\' is not a valid log sink.');
+    });
+  });
+
+  describe('in a worker', function () {
+    this.timeout(10000);
+
+    before(function () {
+      if (!workerThreads) {
+        this.skip();
+      }
+    });
+
+    const source = `
+      const { parentPort } = require('worker_threads');
+      const webrtc = require(${JSON.stringify(path.join(__dirname, '..'))});
+      const pc = new webrtc.RTCPeerConnection();
+
+      // The connection is left open, the environment cleanup must release it.
+      pc.createOffer()
+        .then((desc) => parentPort.postMessage(desc.type),
+              (err) => parentPort.postMessage(err.message))
+        .then(() => process.exit(0));
+    `;
+
+    function runWorker() {
+      return new Promise((resolve, reject) => {
+        const worker = new workerThreads.Worker(source, { eval: true });
+        let result = null;
+
+        worker.on('message', (message) => { result = message; });
+        worker.on('error', reject);
+        worker.on('exit', () => resolve(result));
+      });
+    }
+
+    it('should create an offer', () => {
+      return runWorker().then((type) => assert.equal(type, 'offer'));
+    });
+
+    it('should keep working on the main thread once the worker exited', () => {
+      return runWorker()
+        .then(() => new webrtc.RTCPeerConnection().createOffer())
+        .then((desc) => assert.equal(desc.type, 'offer'));
+    });
+
+    it('should run several workers at once', () => {
+      return Promise.all([runWorker(), runWorker(), runWorker()])
+        .then((types) => assert.deepEqual(types, ['offer', 'offer', 'offer']));
+    });
+  });
+});